@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Baseline for the benchmarks: a number stored as `mantissa * 2^exponent`
+ * with the mantissa normalized to [0.5, 1).
+ *
+ * This is the usual alternative to logarithmic numbers. Multiplications are
+ * cheap, additions need an `ldexp` to align the exponents.
+ */
+struct ScaledDouble {
+    double mantissa = 0.0;
+    std::int64_t exponent = 0;
+
+    ScaledDouble() = default;
+
+    explicit ScaledDouble(double val) { normalize(val, 0); }
+
+    [[nodiscard]] auto to() const -> double {
+        return std::ldexp(this->mantissa, static_cast<int>(this->exponent));
+    }
+
+    auto operator*=(const ScaledDouble &rhs) -> ScaledDouble & {
+        normalize(this->mantissa * rhs.mantissa,
+                  this->exponent + rhs.exponent);
+        return *this;
+    }
+
+    auto operator+=(const ScaledDouble &rhs) -> ScaledDouble & {
+        if (rhs.mantissa == 0.0) {
+            return *this;
+        }
+        if (this->mantissa == 0.0) {
+            *this = rhs;
+            return *this;
+        }
+        // Differences larger than 64 exponents only underflow the mantissa.
+        if (this->exponent >= rhs.exponent) {
+            const auto shift = static_cast<int>(
+                std::min<std::int64_t>(this->exponent - rhs.exponent, 64));
+            normalize(this->mantissa + std::ldexp(rhs.mantissa, -shift),
+                      this->exponent);
+        } else {
+            const auto shift = static_cast<int>(
+                std::min<std::int64_t>(rhs.exponent - this->exponent, 64));
+            normalize(std::ldexp(this->mantissa, -shift) + rhs.mantissa,
+                      rhs.exponent);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] auto operator<(const ScaledDouble &rhs) const -> bool {
+        const bool lhs_neg = this->mantissa < 0.0;
+        const bool rhs_neg = rhs.mantissa < 0.0;
+        if (lhs_neg != rhs_neg || this->mantissa == 0.0 ||
+            rhs.mantissa == 0.0 || this->exponent == rhs.exponent) {
+            return this->to() < rhs.to();
+        }
+        return (this->exponent < rhs.exponent) != lhs_neg;
+    }
+
+   private:
+    void normalize(double new_mantissa, std::int64_t new_exponent) {
+        int shift = 0;
+        this->mantissa = std::frexp(new_mantissa, &shift);
+        this->exponent = new_mantissa == 0.0 ? 0 : new_exponent + shift;
+    }
+};
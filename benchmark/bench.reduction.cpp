@@ -0,0 +1,232 @@
+#include <LogValCpp/AtomicLogVal.hpp>
+#include <LogValCpp/CompensatedLogVal.hpp>
+#include <LogValCpp/ExtFloat.hpp>
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValAccumulator.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <LogValCpp/Matrix.hpp>
+#include <LogValCpp/Normalize.hpp>
+#include <LogValCpp/Parallel.hpp>
+#include <LogValCpp/Sparse.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <ScaledDouble.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Accumulate", "[reduction]") {
+    const auto size = GENERATE(std::size_t{1000}, std::size_t{100000},
+                               std::size_t{1000000});
+    const std::string suffix = " (" + std::to_string(size) + ")";
+
+    std::mt19937_64 gen(size);
+    std::uniform_real_distribution<double> magnitude(-20.0, 20.0);
+    std::bernoulli_distribution negative(0.3);
+
+    std::vector<double> doubles(size);
+    for (auto &val : doubles) {
+        val = std::exp(magnitude(gen)) * (negative(gen) ? -1.0 : 1.0);
+    }
+    const std::vector<long double> long_doubles(doubles.begin(),
+                                                doubles.end());
+    std::vector<ScaledDouble> scaled;
+    std::vector<ExtFloat<double>> extended;
+    std::vector<LogVal<double>> logvals;
+    std::vector<LogVal<long double>> long_logvals;
+    for (const double val : doubles) {
+        scaled.emplace_back(val);
+        extended.emplace_back(val);
+        logvals.emplace_back(val);
+        long_logvals.emplace_back(val);
+    }
+    const LogValArray<double> array(logvals.begin(), logvals.end());
+
+    BENCHMARK("double" + suffix) {
+        return std::accumulate(doubles.begin(), doubles.end(), 0.0);
+    };
+
+    BENCHMARK("long double" + suffix) {
+        return std::accumulate(long_doubles.begin(), long_doubles.end(),
+                               0.0L);
+    };
+
+    BENCHMARK("ScaledDouble" + suffix) {
+        ScaledDouble res;
+        for (const auto &val : scaled) {
+            res += val;
+        }
+        return res;
+    };
+
+    BENCHMARK("ExtFloat std::accumulate" + suffix) {
+        return std::accumulate(extended.begin(), extended.end(),
+                               ExtFloat<double>());
+    };
+
+    BENCHMARK("LogVal std::accumulate" + suffix) {
+        return std::accumulate(logvals.begin(), logvals.end(), LogVal(0.0));
+    };
+
+    BENCHMARK("LogVal<long double> std::accumulate" + suffix) {
+        return std::accumulate(long_logvals.begin(), long_logvals.end(),
+                               LogVal(0.0L));
+    };
+
+    BENCHMARK("CompensatedLogVal" + suffix) {
+        CompensatedLogVal<double> res;
+        for (const auto &val : logvals) {
+            res += val;
+        }
+        return res.value();
+    };
+
+    BENCHMARK("LogVal logval::sum" + suffix) {
+        return logval::sum(logvals.begin(), logvals.end());
+    };
+
+    BENCHMARK("LogValArray logval::sum" + suffix) {
+        return logval::sum(array);
+    };
+
+    BENCHMARK("LogValAccumulator" + suffix) {
+        LogValAccumulator<double> acc;
+        for (const auto &val : logvals) {
+            acc += val;
+        }
+        return acc.result();
+    };
+
+    BENCHMARK("LogVal logval::par::sum" + suffix) {
+        return logval::par::sum(logvals.begin(), logvals.end());
+    };
+}
+
+TEST_CASE("Sparse matrix vector product", "[reduction]") {
+    // Transition matrix with 1% non-zero entries.
+    const std::size_t size = 2000;
+    std::mt19937_64 gen(size);
+    std::uniform_real_distribution<double> magnitude(-20.0, 0.0);
+    std::bernoulli_distribution non_zero(0.01);
+
+    std::vector<LogVal<double>> dense(size * size, LogVal(0.0));
+    for (auto &val : dense) {
+        if (non_zero(gen)) {
+            val = LogVal<double>::from_log(magnitude(gen));
+        }
+    }
+    std::vector<LogVal<double>> x;
+    for (std::size_t i = 0; i < size; ++i) {
+        x.push_back(LogVal<double>::from_log(magnitude(gen)));
+    }
+    std::vector<LogVal<double>> y(size, LogVal(0.0));
+    const logval::MatrixView<const LogVal<double>> view(dense.data(), size,
+                                                        size);
+    const auto csr = logval::CsrMatrix<LogVal<double>>::from_dense(view);
+
+    BENCHMARK("dense gemv") {
+        logval::gemv(view, x.data(), y.data());
+        return y.front();
+    };
+
+    BENCHMARK("CsrMatrix spmv") {
+        logval::spmv(csr, x.data(), y.data());
+        return y.front();
+    };
+
+    BENCHMARK("CsrMatrix logval::par::spmv") {
+        logval::par::spmv(csr, x.data(), y.data());
+        return y.front();
+    };
+}
+
+TEST_CASE("Contended accumulation", "[reduction]") {
+    const auto threads = GENERATE(1U, 4U, 16U);
+    const std::string suffix = " (" + std::to_string(threads) + " threads)";
+    constexpr std::size_t updates = 10000;
+
+    std::vector<LogVal<double>> values;
+    std::mt19937_64 gen(threads);
+    std::uniform_real_distribution<double> magnitude(-20.0, 20.0);
+    for (std::size_t i = 0; i < updates; ++i) {
+        values.push_back(LogVal<double>::from_log(magnitude(gen)));
+    }
+
+    auto run = [threads](auto work) {
+        std::vector<std::jthread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back(work);
+        }
+    };
+
+    BENCHMARK("LogVal with std::mutex" + suffix) {
+        std::mutex mutex;
+        LogVal<double> res(0.0);
+        run([&] {
+            for (const auto &val : values) {
+                const std::lock_guard lock(mutex);
+                res += val;
+            }
+        });
+        return res;
+    };
+
+    BENCHMARK("AtomicLogVal fetch_add" + suffix) {
+        AtomicLogVal<double> res;
+        run([&] {
+            for (const auto &val : values) {
+                res.fetch_add(val, std::memory_order_relaxed);
+            }
+        });
+        return res.load();
+    };
+
+    BENCHMARK("AtomicLogVal fetch_max" + suffix) {
+        AtomicLogVal<double> res;
+        run([&] {
+            for (const auto &val : values) {
+                res.fetch_max(val, std::memory_order_relaxed);
+            }
+        });
+        return res.load();
+    };
+}
+
+TEST_CASE("Normalization", "[reduction]") {
+    const auto size = GENERATE(std::size_t{1000}, std::size_t{100000});
+    const std::string suffix = " (" + std::to_string(size) + ")";
+
+    std::mt19937_64 gen(size);
+    std::uniform_real_distribution<double> magnitude(-1000.0, -900.0);
+    std::vector<LogVal<double>> weights;
+    for (std::size_t i = 0; i < size; ++i) {
+        weights.push_back(LogVal<double>::from_log(magnitude(gen)));
+    }
+    std::vector<double> probabilities(size);
+
+    BENCHMARK("accumulate, divide, to" + suffix) {
+        const auto total =
+            std::accumulate(weights.begin(), weights.end(), LogVal(0.0));
+        for (std::size_t i = 0; i < size; ++i) {
+            probabilities[i] = (weights[i] / total).to();
+        }
+        return probabilities.front();
+    };
+
+    BENCHMARK("logval::to_probabilities" + suffix) {
+        logval::to_probabilities(std::span(weights), std::span(probabilities));
+        return probabilities.front();
+    };
+
+    BENCHMARK("logval::normalize" + suffix) {
+        return logval::normalize(std::span(weights));
+    };
+}
@@ -0,0 +1,258 @@
+#include <LogValCpp/Combinatorics.hpp>
+#include <LogValCpp/Expression.hpp>
+#include <LogValCpp/ExtFloat.hpp>
+#include <LogValCpp/Format.hpp>
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <ScaledDouble.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Power of two, so that the index can be wrapped with a mask.
+constexpr std::size_t input_size = 1024;
+
+// Positive values spread over several orders of magnitude, negated with
+// `negative_share` probability.
+auto make_inputs(unsigned seed, double negative_share) -> std::vector<double> {
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> magnitude(-20.0, 20.0);
+    std::bernoulli_distribution negative(negative_share);
+
+    std::vector<double> res(input_size);
+    for (auto &val : res) {
+        val = std::exp(magnitude(gen)) * (negative(gen) ? -1.0 : 1.0);
+    }
+    return res;
+}
+
+template <typename V>
+auto convert(const std::vector<double> &values) -> std::vector<V> {
+    std::vector<V> res;
+    res.reserve(values.size());
+    for (const double val : values) {
+        res.emplace_back(val);
+    }
+    return res;
+}
+
+/**
+ * Benchmark `op(lhs[i], rhs[i])` for all value types.
+ *
+ * The operands are read from arrays, so that the compiler can not fold the
+ * operations into constants.
+ */
+template <typename Op>
+void bench_binary(const std::string &name, const std::vector<double> &lhs,
+                  const std::vector<double> &rhs, Op op) {
+    auto bench = [&name, op]<typename V>(const std::vector<V> &lhs_values,
+                                         const std::vector<V> &rhs_values,
+                                         const std::string &type) {
+        BENCHMARK_ADVANCED(name + " " + type)
+        (Catch::Benchmark::Chronometer meter) {
+            meter.measure([&](int i) {
+                const auto index =
+                    static_cast<std::size_t>(i) & (input_size - 1);
+                return op(lhs_values[index], rhs_values[index]);
+            });
+        };
+    };
+
+    bench(lhs, rhs, "double");
+    bench(convert<long double>(lhs), convert<long double>(rhs),
+          "long double");
+    bench(convert<ScaledDouble>(lhs), convert<ScaledDouble>(rhs),
+          "ScaledDouble");
+    bench(convert<ExtFloat<double>>(lhs), convert<ExtFloat<double>>(rhs),
+          "ExtFloat<double>");
+    bench(convert<LogVal<double>>(lhs), convert<LogVal<double>>(rhs),
+          "LogVal<double>");
+    bench(convert<LogVal<double, FastMath<1024>>>(lhs),
+          convert<LogVal<double, FastMath<1024>>>(rhs),
+          "LogVal FastMath<1024>");
+}
+
+}  // namespace
+
+TEST_CASE("Construction and conversion", "[scalar]") {
+    const auto values = make_inputs(1, 0.5);
+
+    BENCHMARK_ADVANCED("construct LogVal<double>")
+    (Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            return LogVal<double>(
+                values[static_cast<std::size_t>(i) & (input_size - 1)]);
+        });
+    };
+
+    BENCHMARK_ADVANCED("construct ScaledDouble")
+    (Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            return ScaledDouble(
+                values[static_cast<std::size_t>(i) & (input_size - 1)]);
+        });
+    };
+
+    const auto logvals = convert<LogVal<double>>(values);
+    BENCHMARK_ADVANCED("to LogVal<double>")
+    (Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            return logvals[static_cast<std::size_t>(i) & (input_size - 1)]
+                .to();
+        });
+    };
+
+    const auto scaled = convert<ScaledDouble>(values);
+    BENCHMARK_ADVANCED("to ScaledDouble")
+    (Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            return scaled[static_cast<std::size_t>(i) & (input_size - 1)]
+                .to();
+        });
+    };
+}
+
+TEST_CASE("Addition", "[scalar]") {
+    const auto positive_lhs = make_inputs(2, 0.0);
+    const auto positive_rhs = make_inputs(3, 0.0);
+    const auto mixed_lhs = make_inputs(4, 0.0);
+    const auto mixed_rhs = make_inputs(5, 1.0);
+
+    auto add = [](auto lhs, const auto &rhs) {
+        lhs += rhs;
+        return lhs;
+    };
+
+    bench_binary("add same sign", positive_lhs, positive_rhs, add);
+    bench_binary("add mixed sign", mixed_lhs, mixed_rhs, add);
+}
+
+TEST_CASE("Multiplication", "[scalar]") {
+    const auto lhs = make_inputs(6, 0.5);
+    const auto rhs = make_inputs(7, 0.5);
+
+    bench_binary("multiply", lhs, rhs, [](auto lhs_val, const auto &rhs_val) {
+        lhs_val *= rhs_val;
+        return lhs_val;
+    });
+}
+
+TEST_CASE("Comparison", "[scalar]") {
+    const auto lhs = make_inputs(8, 0.5);
+    const auto rhs = make_inputs(9, 0.5);
+
+    bench_binary("less", lhs, rhs, [](const auto &lhs_val,
+                                      const auto &rhs_val) {
+        return lhs_val < rhs_val;
+    });
+}
+
+TEST_CASE("Sum of products", "[scalar]") {
+    const auto values = convert<LogVal<double>>(make_inputs(10, 0.5));
+
+    auto at = [&values](int i, std::size_t offset) {
+        return values[(static_cast<std::size_t>(i) + offset) &
+                      (input_size - 1)];
+    };
+
+    BENCHMARK_ADVANCED("a*b + c*d + e chained")
+    (Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            return at(i, 0) * at(i, 1) + at(i, 2) * at(i, 3) + at(i, 4);
+        });
+    };
+
+    BENCHMARK_ADVANCED("a*b + c*d + e lazy")
+    (Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            return logval::eval(logval::lazy(at(i, 0)) * at(i, 1) +
+                                at(i, 2) * at(i, 3) + at(i, 4));
+        });
+    };
+}
+
+TEST_CASE("Text conversion", "[scalar]") {
+    const auto values = make_inputs(11, 0.5);
+    const auto logvals = convert<LogVal<double>>(values);
+
+    std::vector<std::array<char, 32>> texts(input_size);
+    std::vector<std::size_t> lengths(input_size);
+    for (std::size_t i = 0; i < input_size; ++i) {
+        const auto res = logval::to_chars(
+            texts[i].data(), texts[i].data() + texts[i].size(), logvals[i]);
+        lengths[i] = static_cast<std::size_t>(res.ptr - texts[i].data());
+    }
+
+    BENCHMARK_ADVANCED("to_chars double")
+    (Catch::Benchmark::Chronometer meter) {
+        std::array<char, 32> buffer{};
+        meter.measure([&](int i) {
+            return std::to_chars(
+                       buffer.data(), buffer.data() + buffer.size(),
+                       values[static_cast<std::size_t>(i) & (input_size - 1)])
+                .ptr;
+        });
+    };
+
+    BENCHMARK_ADVANCED("to_chars LogVal<double>")
+    (Catch::Benchmark::Chronometer meter) {
+        std::array<char, 32> buffer{};
+        meter.measure([&](int i) {
+            return logval::to_chars(
+                       buffer.data(), buffer.data() + buffer.size(),
+                       logvals[static_cast<std::size_t>(i) & (input_size - 1)])
+                .ptr;
+        });
+    };
+
+    BENCHMARK_ADVANCED("from_chars LogVal<double>")
+    (Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            const auto index = static_cast<std::size_t>(i) & (input_size - 1);
+            LogVal<double> res(0.0);
+            logval::from_chars(texts[index].data(),
+                               texts[index].data() + lengths[index], res);
+            return res;
+        });
+    };
+}
+
+TEST_CASE("Binomial coefficients", "[scalar]") {
+    std::mt19937_64 rng(13);
+    std::uniform_int_distribution<std::uint64_t> dist_n(0, 20000);
+    std::vector<std::uint64_t> ns(input_size);
+    std::vector<std::uint64_t> ks(input_size);
+    for (std::size_t i = 0; i < input_size; ++i) {
+        ns[i] = dist_n(rng);
+        ks[i] = std::uniform_int_distribution<std::uint64_t>(0, ns[i])(rng);
+    }
+
+    BENCHMARK_ADVANCED("binomial lgamma")
+    (Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            const auto index = static_cast<std::size_t>(i) & (input_size - 1);
+            const auto n = static_cast<double>(ns[index]);
+            const auto k = static_cast<double>(ks[index]);
+            return LogVal<double>::from_log(std::lgamma(n + 1.0) -
+                                            std::lgamma(k + 1.0) -
+                                            std::lgamma(n - k + 1.0));
+        });
+    };
+
+    BENCHMARK_ADVANCED("binomial combinatorics")
+    (Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            const auto index = static_cast<std::size_t>(i) & (input_size - 1);
+            return logval::combinatorics::binomial(ns[index], ks[index]);
+        });
+    };
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <LogValCpp/PackedLogVal.hpp>
+#include <atomic>
+#include <concepts>
+
+/**
+ * Atomic LogVal for accumulators shared between threads.
+ *
+ * `std::atomic<LogVal<double>>` is 16 bytes large and not lock-free on most
+ * targets. AtomicLogVal stores the bits of a PackedLogVal instead, so it is
+ * lock-free wherever `std::atomic<std::uint64_t>` (or `std::uint32_t` for
+ * `float`) is, e.g. on x86-64 and AArch64.
+ *
+ * The read-modify-write operations unpack the current value, apply the
+ * LogVal operator and publish the result with a compare-exchange loop, so
+ * they have the semantics of `operator+=` and `operator*=` plus the rounding
+ * of PackedLogVal (at most one ulp of the logarithm per update).
+ *
+ * \code
+ * AtomicLogVal<double> partition;
+ * // on many threads
+ * partition.fetch_add(weight);
+ * \endcode
+ */
+template <typename T = double, typename Policy = ExactMath>
+    requires(std::same_as<T, float> || std::same_as<T, double>) &&
+            LogValMathPolicy<Policy, T>
+class AtomicLogVal {
+   public:
+    using value_type = LogVal<T, Policy>;
+    using packed_type = PackedLogVal<T, Policy>;
+    using bits_type = typename packed_type::bits_type;
+
+    static constexpr bool is_always_lock_free =
+        std::atomic<bits_type>::is_always_lock_free;
+
+    /** Zero. */
+    AtomicLogVal() noexcept
+        : AtomicLogVal(value_type::from_log(T(0), value_type::Sign::null)) {}
+
+    explicit AtomicLogVal(const value_type &val) noexcept
+        : bits_(packed_type(val).bits()) {}
+
+    AtomicLogVal(const AtomicLogVal &) = delete;
+    auto operator=(const AtomicLogVal &) -> AtomicLogVal & = delete;
+
+    [[nodiscard]] auto is_lock_free() const noexcept -> bool {
+        return this->bits_.is_lock_free();
+    }
+
+    [[nodiscard]] auto load(std::memory_order order =
+                                std::memory_order_seq_cst) const noexcept
+        -> value_type {
+        return unpack(this->bits_.load(order));
+    }
+
+    void store(const value_type &val,
+               std::memory_order order = std::memory_order_seq_cst) noexcept {
+        this->bits_.store(packed_type(val).bits(), order);
+    }
+
+    /**
+     * Replace the value with `val`.
+     *
+     * @returns the previous value.
+     */
+    auto exchange(const value_type &val,
+                  std::memory_order order = std::memory_order_seq_cst) noexcept
+        -> value_type {
+        return unpack(this->bits_.exchange(packed_type(val).bits(), order));
+    }
+
+    /**
+     * Replace the value with `desired` if it is equal to `expected` (after
+     * packing), otherwise load the current value into `expected`.
+     *
+     * @returns whether the value was replaced.
+     */
+    auto compare_exchange_weak(
+        value_type &expected, const value_type &desired,
+        std::memory_order order = std::memory_order_seq_cst) noexcept
+        -> bool {
+        bits_type expected_bits = packed_type(expected).bits();
+        const bool res = this->bits_.compare_exchange_weak(
+            expected_bits, packed_type(desired).bits(), order);
+        expected = unpack(expected_bits);
+        return res;
+    }
+
+    auto compare_exchange_strong(
+        value_type &expected, const value_type &desired,
+        std::memory_order order = std::memory_order_seq_cst) noexcept
+        -> bool {
+        bits_type expected_bits = packed_type(expected).bits();
+        const bool res = this->bits_.compare_exchange_strong(
+            expected_bits, packed_type(desired).bits(), order);
+        expected = unpack(expected_bits);
+        return res;
+    }
+
+    /**
+     * Atomically add `val` like `operator+=`.
+     *
+     * @returns the previous value.
+     */
+    auto fetch_add(const value_type &val,
+                   std::memory_order order = std::memory_order_seq_cst) noexcept
+        -> value_type {
+        return this->update(
+            [&val](value_type current) { return current += val; }, order);
+    }
+
+    auto fetch_sub(const value_type &val,
+                   std::memory_order order = std::memory_order_seq_cst) noexcept
+        -> value_type {
+        return this->update(
+            [&val](value_type current) { return current -= val; }, order);
+    }
+
+    /**
+     * Atomically multiply with `val` like `operator*=`.
+     *
+     * @returns the previous value.
+     */
+    auto fetch_mul(const value_type &val,
+                   std::memory_order order = std::memory_order_seq_cst) noexcept
+        -> value_type {
+        return this->update(
+            [&val](value_type current) { return current *= val; }, order);
+    }
+
+    /**
+     * Atomically replace the value with `val` if `val` is larger.
+     *
+     * Nothing is written if the current value is not smaller, then the
+     * operation is only a load with `order` without its release part, like
+     * a failed `compare_exchange_weak`.
+     *
+     * @returns the previous value.
+     */
+    auto fetch_max(const value_type &val,
+                   std::memory_order order = std::memory_order_seq_cst) noexcept
+        -> value_type {
+        const bits_type desired = packed_type(val).bits();
+        bits_type expected = this->bits_.load(load_order(order));
+        // Compare the packed values, which are what is stored.
+        while (packed_type::from_bits(expected) <
+               packed_type::from_bits(desired)) {
+            if (this->bits_.compare_exchange_weak(expected, desired, order)) {
+                break;
+            }
+        }
+        return unpack(expected);
+    }
+
+   private:
+    /** `order` without release, which is not valid for loads. */
+    [[nodiscard]] static constexpr auto load_order(
+        std::memory_order order) noexcept -> std::memory_order {
+        switch (order) {
+            case std::memory_order_release:
+                return std::memory_order_relaxed;
+            case std::memory_order_acq_rel:
+                return std::memory_order_acquire;
+            default:
+                return order;
+        }
+    }
+
+    [[nodiscard]] static auto unpack(bits_type bits) noexcept -> value_type {
+        return packed_type::from_bits(bits).unpack();
+    }
+
+    /** Compare-exchange loop publishing `op(current)`. */
+    template <typename Op>
+    auto update(Op op, std::memory_order order) noexcept -> value_type {
+        bits_type expected = this->bits_.load(std::memory_order_relaxed);
+        while (!this->bits_.compare_exchange_weak(
+            expected, packed_type(op(unpack(expected))).bits(), order)) {
+        }
+        return unpack(expected);
+    }
+
+    std::atomic<bits_type> bits_;
+};
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <LogValCpp/detail/TwoSum.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <span>
+#include <type_traits>
+
+/**
+ * Factorials, binomial and multinomial coefficients as LogVals, and powers
+ * and roots of LogVals.
+ *
+ * `log(n!)` for `n < 65536` is read from a table of double-double values,
+ * which is grown on demand and can be read by many threads without locks.
+ * Larger factorials use Stirling's series. Binomial coefficients of large
+ * arguments are evaluated from
+ * \f[
+ *   \log\frac{n!}{(n-k)!} = k\log n - (n-k)\,\mathrm{log1p}(-k/n) - k
+ *                           + \tfrac12\,\mathrm{log1p}\bigl(k/(n-k)\bigr)
+ *                           + \ldots
+ * \f]
+ * instead of the difference of three factorials, so that they keep their
+ * relative accuracy.
+ */
+namespace logval {
+
+namespace detail {
+
+/** `hi + lo` with `|lo| <= ulp(hi) / 2`. */
+struct DoubleDouble {
+    double hi;
+    double lo;
+};
+
+/**
+ * Table of `log(n!)` for `n < max_size`, grown by chunks on first access.
+ *
+ * A chunk is filled completely before `size_` is increased (release), hence
+ * readers only need to load `size_` (acquire). Growing is serialized by a
+ * mutex. The terms `log(n)` are computed in `long double` and summed in
+ * double-double, the entries are accurate to about `1e-16` absolute.
+ */
+class LogFactorialTable {
+   public:
+    static constexpr std::size_t chunk_size = 4096;
+    static constexpr std::size_t max_size = std::size_t{1} << 16;
+
+    [[nodiscard]] static auto instance() -> LogFactorialTable & {
+        static LogFactorialTable table;
+        return table;
+    }
+
+    /** `log(n!)` for `n < max_size`. */
+    [[nodiscard]] auto get(std::size_t n) -> DoubleDouble {
+        if (n >= this->size_.load(std::memory_order_acquire)) {
+            this->grow(n);
+        }
+        return this->chunks_[n / chunk_size][n % chunk_size];
+    }
+
+   private:
+    LogFactorialTable() = default;
+
+    void grow(std::size_t n) {
+        const std::lock_guard lock(this->mutex_);
+        std::size_t size = this->size_.load(std::memory_order_relaxed);
+        while (size <= n) {
+            auto chunk = std::make_unique<DoubleDouble[]>(chunk_size);
+            for (std::size_t i = 0; i < chunk_size; ++i) {
+                const std::size_t k = size + i;
+                if (k > 1) {
+                    const long double term =
+                        std::log(static_cast<long double>(k));
+                    const auto term_hi = static_cast<double>(term);
+                    const auto term_lo = static_cast<double>(term - term_hi);
+                    const auto sum = two_sum(this->last_.hi, term_hi);
+                    const auto res = fast_two_sum(
+                        sum.sum, sum.error + (this->last_.lo + term_lo));
+                    this->last_ = {res.sum, res.error};
+                }
+                chunk[i] = this->last_;
+            }
+            this->chunks_[size / chunk_size] = std::move(chunk);
+            size += chunk_size;
+            this->size_.store(size, std::memory_order_release);
+        }
+    }
+
+    std::array<std::unique_ptr<DoubleDouble[]>, max_size / chunk_size>
+        chunks_{};
+    std::atomic<std::size_t> size_{0};
+    DoubleDouble last_{0.0, 0.0};
+    std::mutex mutex_;
+};
+
+/**
+ * `log(n!) - (n log(n) - n + log(2 pi n) / 2)`, the tail of Stirling's
+ * series, accurate to `1e-20` for `n >= 256`.
+ */
+[[nodiscard]] inline auto stirling_tail(double n) -> double {
+    const double inv = 1.0 / n;
+    const double inv2 = inv * inv;
+    return inv *
+           (1.0 / 12.0 -
+            inv2 * (1.0 / 360.0 - inv2 * (1.0 / 1260.0 - inv2 / 1680.0)));
+}
+
+/**
+ * `log(n! / (n - k)!)` for `n >= LogFactorialTable::max_size`.
+ */
+[[nodiscard]] inline auto log_falling_factorial(std::uint64_t n,
+                                                std::uint64_t k) -> double {
+    const auto n_real = static_cast<double>(n);
+    const auto k_real = static_cast<double>(k);
+    const auto m_real = static_cast<double>(n - k);
+    return k_real * std::log(n_real) -
+           m_real * std::log1p(-k_real / n_real) - k_real +
+           0.5 * std::log1p(k_real / m_real) +
+           (stirling_tail(n_real) - stirling_tail(m_real));
+}
+
+}  // namespace detail
+
+namespace combinatorics {
+
+/**
+ * Natural logarithm of `n!`.
+ */
+[[nodiscard]] inline auto log_factorial(std::uint64_t n) -> double {
+    using logval::detail::LogFactorialTable;
+    if (n < LogFactorialTable::max_size) {
+        const auto entry = LogFactorialTable::instance().get(n);
+        return entry.hi + entry.lo;
+    }
+    const auto n_real = static_cast<double>(n);
+    return n_real * (std::log(n_real) - 1.0) +
+           0.5 * std::log(2.0 * std::numbers::pi * n_real) +
+           logval::detail::stirling_tail(n_real);
+}
+
+/**
+ * Natural logarithm of the binomial coefficient `n` over `k`, `-inf` for
+ * `k > n`.
+ */
+[[nodiscard]] inline auto log_binomial(std::uint64_t n, std::uint64_t k)
+    -> double {
+    using logval::detail::LogFactorialTable;
+    if (k > n) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    k = std::min(k, n - k);
+    if (n < LogFactorialTable::max_size) {
+        // Difference of the double-double entries, without cancellation.
+        auto &table = LogFactorialTable::instance();
+        const auto total = table.get(n);
+        const auto lhs = table.get(k);
+        const auto rhs = table.get(n - k);
+        const auto first = logval::detail::two_sum(total.hi, -lhs.hi);
+        const auto second = logval::detail::two_sum(first.sum, -rhs.hi);
+        return second.sum + ((first.error + second.error) +
+                             (total.lo - lhs.lo - rhs.lo));
+    }
+    return logval::detail::log_falling_factorial(n, k) - log_factorial(k);
+}
+
+/**
+ * Natural logarithm of the multinomial coefficient
+ * `(k_1 + ... + k_m)! / (k_1! ... k_m!)`.
+ */
+[[nodiscard]] inline auto log_multinomial(
+    std::span<const std::uint64_t> counts) -> double {
+    // Product of binomials, each of them accurate.
+    std::uint64_t total = 0;
+    double res = 0.0;
+    for (const std::uint64_t count : counts) {
+        total += count;
+        res += log_binomial(total, count);
+    }
+    return res;
+}
+
+/**
+ * `n!`
+ */
+template <typename T = double, typename Policy = ExactMath>
+[[nodiscard]] auto factorial(std::uint64_t n) -> LogVal<T, Policy> {
+    using V = LogVal<T, Policy>;
+    return logval::detail::from_natural_log<V>(
+        static_cast<T>(log_factorial(n)), V::Sign::positive);
+}
+
+/**
+ * Binomial coefficient `n` over `k`, zero for `k > n`.
+ */
+template <typename T = double, typename Policy = ExactMath>
+[[nodiscard]] auto binomial(std::uint64_t n, std::uint64_t k)
+    -> LogVal<T, Policy> {
+    using V = LogVal<T, Policy>;
+    if (k > n) {
+        return V::from_log(T(0), V::Sign::null);
+    }
+    return logval::detail::from_natural_log<V>(
+        static_cast<T>(log_binomial(n, k)), V::Sign::positive);
+}
+
+/**
+ * Multinomial coefficient of `counts`, e.g. the number of arrangements of
+ * `counts[i]` indistinguishable objects of kind `i`.
+ */
+template <typename T = double, typename Policy = ExactMath>
+[[nodiscard]] auto multinomial(std::span<const std::uint64_t> counts)
+    -> LogVal<T, Policy> {
+    using V = LogVal<T, Policy>;
+    return logval::detail::from_natural_log<V>(
+        static_cast<T>(log_multinomial(counts)), V::Sign::positive);
+}
+
+template <typename T = double, typename Policy = ExactMath,
+          std::integral... Counts>
+    requires(sizeof...(Counts) > 0)
+[[nodiscard]] auto multinomial(Counts... counts) -> LogVal<T, Policy> {
+    const std::array<std::uint64_t, sizeof...(Counts)> values{
+        static_cast<std::uint64_t>(counts)...};
+    return multinomial<T, Policy>(std::span<const std::uint64_t>(values));
+}
+
+}  // namespace combinatorics
+
+/**
+ * `base` to the power of `exponent`.
+ *
+ * Negative bases need an integral exponent, otherwise the result is `nan`.
+ * The exponent is not deduced, so integers like in `pow(val, 2)` convert.
+ */
+template <typename T, typename Policy>
+[[nodiscard]] auto pow(const LogVal<T, Policy> &base,
+                       std::type_identity_t<T> exponent)
+    -> LogVal<T, Policy> {
+    using V = LogVal<T, Policy>;
+    using Sign = typename V::Sign;
+    if (exponent == T(0)) {
+        return V::from_log(T(0), Sign::positive);
+    }
+    if (base.sign() == Sign::null) {
+        return exponent > T(0)
+                   ? V::from_log(T(0), Sign::null)
+                   : V::from_log(std::numeric_limits<T>::infinity(),
+                                 Sign::positive);
+    }
+    Sign sign = Sign::positive;
+    if (base.sign() == Sign::negative) {
+        if (std::trunc(exponent) != exponent) {
+            return V::from_log(std::numeric_limits<T>::quiet_NaN(),
+                               Sign::positive);
+        }
+        if (std::fmod(exponent, T(2)) != T(0)) {
+            sign = Sign::negative;
+        }
+    }
+    return V::from_log(base.log_abs() * exponent, sign);
+}
+
+/**
+ * Square root of `val`, `nan` for negative values.
+ */
+template <typename T, typename Policy>
+[[nodiscard]] auto sqrt(const LogVal<T, Policy> &val) -> LogVal<T, Policy> {
+    using V = LogVal<T, Policy>;
+    using Sign = typename V::Sign;
+    if (val.sign() == Sign::negative) {
+        return V::from_log(std::numeric_limits<T>::quiet_NaN(),
+                           Sign::positive);
+    }
+    return V::from_log(val.log_abs() / T(2), val.sign());
+}
+
+namespace combinatorics {
+
+using logval::pow;
+using logval::sqrt;
+
+}  // namespace combinatorics
+
+}  // namespace logval
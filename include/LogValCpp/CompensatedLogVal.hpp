@@ -0,0 +1,194 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/detail/TwoSum.hpp>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <numbers>
+
+/**
+ * LogVal with a compensated logarithm for long chains of additions.
+ *
+ * Every addition of a LogVal rounds its logarithm, i.e. it loses about
+ * `ulp(log)` in absolute terms even if the addend is tiny compared to the
+ * sum. Over millions of additions these errors add up, which so far required
+ * `LogVal<long double>`.
+ *
+ * CompensatedLogVal stores the logarithm as an unevaluated sum `hi + lo`
+ * (double-double). An addition costs the same `exp` and `log1p` as for
+ * LogVal, the rounding of the logarithm is captured in `lo` by a TwoSum,
+ * and the error of `hi - lo` of the operands is propagated to first order.
+ * The only remaining errors are those of `exp` and `log1p` relative to the
+ * change of the logarithm, hence the accuracy is close to
+ * `LogVal<long double>` at close to the speed of `LogVal<double>`.
+ *
+ * The logarithm is natural (as for the default `ExactMath` policy). The
+ * compensation requires IEEE arithmetic and does not work with
+ * `-ffast-math`.
+ *
+ * \code
+ * CompensatedLogVal<double> sum;
+ * for (const auto &val : values) {
+ *     sum += val;
+ * }
+ * const LogVal<double> res = sum.value();
+ * \endcode
+ */
+template <typename T = double>
+    requires std::floating_point<T>
+class CompensatedLogVal {
+   public:
+    using value_type = T;
+    using Sign = typename LogVal<T>::Sign;
+
+    /** Zero. */
+    CompensatedLogVal() = default;
+
+    explicit CompensatedLogVal(const LogVal<T> val)
+        : hi_(val.sign() == Sign::null ? -std::numeric_limits<T>::infinity()
+                                       : val.log_abs()),
+          sign_(val.sign()) {}
+
+    explicit CompensatedLogVal(T val) : CompensatedLogVal(LogVal<T>(val)) {}
+
+    /**
+     * Adds `rhs` to this value.
+     *
+     * @returns reference to this value.
+     */
+    auto operator+=(const CompensatedLogVal &rhs) noexcept
+        -> CompensatedLogVal & {
+        if (rhs.sign_ == Sign::null) {
+            return *this;
+        }
+        if (this->sign_ == Sign::null) {
+            *this = rhs;
+            return *this;
+        }
+
+        // Order the operands by the magnitude of `hi + lo`.
+        const bool rhs_larger =
+            rhs.hi_ > this->hi_ || (rhs.hi_ == this->hi_ && rhs.lo_ > this->lo_);
+        const CompensatedLogVal &larger = rhs_larger ? rhs : *this;
+        const CompensatedLogVal &smaller = rhs_larger ? *this : rhs;
+        const bool same_sign = this->sign_ == rhs.sign_;
+        if (!same_sign && larger.hi_ == smaller.hi_ &&
+            larger.lo_ == smaller.lo_) {
+            *this = CompensatedLogVal();
+            return *this;
+        }
+
+        // smaller / larger = t * (1 + delta)
+        const auto diff = logval::detail::two_sum(smaller.hi_, -larger.hi_);
+        const T delta = diff.error + (smaller.lo_ - larger.lo_);
+        const T t = std::exp(diff.sum);
+
+        // log(1 +- t (1 + delta)) = log1p(+-t) + correction
+        T step;
+        T correction = T(0);
+        if (same_sign) {
+            step = std::log1p(t);
+            correction = t * delta / (T(1) + t);
+        } else if (diff.sum > -std::numbers::ln2_v<T>) {
+            // Cancellation, the difference of the logarithms is small and
+            // `delta` is included directly.
+            step = std::log(-std::expm1(diff.sum + delta));
+        } else {
+            step = std::log1p(-t);
+            correction = -t * delta / (T(1) - t);
+        }
+
+        const auto res = logval::detail::two_sum(larger.hi_, step);
+        const auto normalized = logval::detail::fast_two_sum(
+            res.sum, res.error + (larger.lo_ + correction));
+        this->sign_ = larger.sign_;
+        this->hi_ = normalized.sum;
+        this->lo_ = normalized.error;
+        return *this;
+    }
+
+    auto operator+=(const LogVal<T> rhs) noexcept -> CompensatedLogVal & {
+        return *this += CompensatedLogVal(rhs);
+    }
+
+    auto operator-=(const CompensatedLogVal &rhs) noexcept
+        -> CompensatedLogVal & {
+        return *this += -rhs;
+    }
+
+    auto operator-=(const LogVal<T> rhs) noexcept -> CompensatedLogVal & {
+        return *this += CompensatedLogVal(-rhs);
+    }
+
+    /**
+     * Multiplies this value with `rhs`, the sum of the logarithms is exact up
+     * to the precision of `hi + lo`.
+     *
+     * @returns reference to this value.
+     */
+    auto operator*=(const CompensatedLogVal &rhs) noexcept
+        -> CompensatedLogVal & {
+        return this->multiply(rhs, T(1));
+    }
+
+    auto operator*=(const LogVal<T> rhs) noexcept -> CompensatedLogVal & {
+        return *this *= CompensatedLogVal(rhs);
+    }
+
+    auto operator/=(const CompensatedLogVal &rhs) noexcept
+        -> CompensatedLogVal & {
+        return this->multiply(rhs, T(-1));
+    }
+
+    auto operator/=(const LogVal<T> rhs) noexcept -> CompensatedLogVal & {
+        return *this /= CompensatedLogVal(rhs);
+    }
+
+    [[nodiscard]] auto operator-() const noexcept -> CompensatedLogVal {
+        CompensatedLogVal res = *this;
+        res.sign_ = static_cast<Sign>(-static_cast<int>(res.sign_));
+        return res;
+    }
+
+    /**
+     * Value rounded to a LogVal, i.e. with the logarithm `hi + lo`.
+     */
+    [[nodiscard]] auto value() const noexcept -> LogVal<T> {
+        return LogVal<T>::from_log(this->hi_ + this->lo_, this->sign_);
+    }
+
+    template <typename ToType = T>
+    [[nodiscard]] auto to() const noexcept -> ToType {
+        return this->value().template to<ToType>();
+    }
+
+    /** Leading part of the logarithm of the absolute value. */
+    [[nodiscard]] auto log_hi() const noexcept -> T { return this->hi_; }
+
+    /** Trailing part of the logarithm, `|lo| <= ulp(hi) / 2`. */
+    [[nodiscard]] auto log_lo() const noexcept -> T { return this->lo_; }
+
+    [[nodiscard]] auto sign() const noexcept -> Sign { return this->sign_; }
+
+   private:
+    auto multiply(const CompensatedLogVal &rhs, T direction) noexcept
+        -> CompensatedLogVal & {
+        this->sign_ = static_cast<Sign>(static_cast<int>(this->sign_) *
+                                        static_cast<int>(rhs.sign_));
+        if (this->sign_ == Sign::null) {
+            *this = CompensatedLogVal();
+            return *this;
+        }
+        const auto res = logval::detail::two_sum(this->hi_, direction * rhs.hi_);
+        const auto normalized = logval::detail::fast_two_sum(
+            res.sum, res.error + (this->lo_ + direction * rhs.lo_));
+        this->hi_ = normalized.sum;
+        this->lo_ = normalized.error;
+        return *this;
+    }
+
+    T hi_ = -std::numeric_limits<T>::infinity();
+    T lo_ = T(0);
+    Sign sign_ = Sign::null;
+};
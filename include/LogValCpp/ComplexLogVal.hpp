@@ -0,0 +1,275 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <limits>
+#include <numbers>
+#include <ostream>
+
+/**
+ * Complex number stored as the logarithm of its magnitude and its phase.
+ *
+ * Like LogVal for real numbers, this allows complex values with a dynamic
+ * range far beyond `std::complex<T>`. Multiplications and divisions only add
+ * logarithms and phases, additions need an `exp`, a `log` and an `atan2`.
+ *
+ * The phase is kept in (-pi, pi], zero is stored with a logarithm of `-inf`
+ * and phase zero.
+ */
+template <typename T = double>
+    requires std::floating_point<T>
+class ComplexLogVal {
+   public:
+    using value_type = T;
+
+    ComplexLogVal() = default;
+
+    explicit ComplexLogVal(std::complex<T> val)
+        : log_abs_(std::log(std::abs(val))), phase_(std::arg(val)) {
+        if (val == std::complex<T>(T(0))) {
+            this->phase_ = T(0);
+        }
+    }
+
+    explicit ComplexLogVal(const LogVal<T> &val) {
+        switch (val.sign()) {
+            case LogVal<T>::Sign::positive:
+                this->log_abs_ = val.log_abs();
+                break;
+            case LogVal<T>::Sign::negative:
+                this->log_abs_ = val.log_abs();
+                this->phase_ = std::numbers::pi_v<T>;
+                break;
+            default:
+                break;
+        }
+    }
+
+    /**
+     * Create a ComplexLogVal from the logarithm of its magnitude and its
+     * phase, which can be any angle.
+     *
+     * @returns a ComplexLogVal equivalent to `exp(log_abs + i * phase)`.
+     */
+    [[nodiscard]] static auto from_log(T log_abs, T phase = T(0)) noexcept
+        -> ComplexLogVal {
+        ComplexLogVal res;
+        if (log_abs != -std::numeric_limits<T>::infinity()) {
+            res.log_abs_ = log_abs;
+            res.phase_ = wrap(phase);
+        }
+        return res;
+    }
+
+    /**
+     * Converts this ComplexLogVal into `std::complex<T>`.
+     *
+     * @returns this ComplexLogVal as `std::complex<T>`.
+     */
+    [[nodiscard]] auto to() const -> std::complex<T> {
+        return std::polar(std::exp(this->log_abs_), this->phase_);
+    }
+
+    /**
+     * Return the logarithm of the magnitude.
+     *
+     * @returns `log(|z|)`, which is `-inf` for zero.
+     */
+    [[nodiscard]] auto log_abs() const noexcept -> T { return this->log_abs_; }
+
+    /** Return the phase in (-pi, pi]. */
+    [[nodiscard]] auto phase() const noexcept -> T { return this->phase_; }
+
+    [[nodiscard]] auto is_zero() const noexcept -> bool {
+        return this->log_abs_ == -std::numeric_limits<T>::infinity();
+    }
+
+    /**
+     * Real part as LogVal, which does not overflow.
+     */
+    [[nodiscard]] auto real() const -> LogVal<T> {
+        return part(std::cos(this->phase_));
+    }
+
+    /**
+     * Imaginary part as LogVal, which does not overflow.
+     */
+    [[nodiscard]] auto imag() const -> LogVal<T> {
+        return part(std::sin(this->phase_));
+    }
+
+    /** Magnitude as LogVal. */
+    [[nodiscard]] auto abs() const noexcept -> LogVal<T> {
+        return is_zero() ? LogVal<T>(T(0))
+                         : LogVal<T>::from_log(this->log_abs_);
+    }
+
+    [[nodiscard]] auto conj() const noexcept -> ComplexLogVal {
+        ComplexLogVal res = *this;
+        // Keep the phase of negative reals at pi.
+        if (res.phase_ != std::numbers::pi_v<T>) {
+            res.phase_ = -res.phase_;
+        }
+        return res;
+    }
+
+    auto operator*=(const ComplexLogVal &rhs) noexcept -> ComplexLogVal & {
+        if (is_zero() || rhs.is_zero()) {
+            *this = ComplexLogVal();
+            return *this;
+        }
+        this->log_abs_ += rhs.log_abs_;
+        this->phase_ = wrap(this->phase_ + rhs.phase_);
+
+        return *this;
+    }
+
+    auto operator/=(const ComplexLogVal &rhs) noexcept -> ComplexLogVal & {
+        // Zero keeps its phase of zero.
+        if (is_zero()) {
+            return *this;
+        }
+        // No special treatment for division with 0, like LogVal.
+        this->log_abs_ -= rhs.log_abs_;
+        this->phase_ = wrap(this->phase_ - rhs.phase_);
+
+        return *this;
+    }
+
+    /**
+     * Adds `rhs` to this ComplexLogVal.
+     *
+     * With `z_1` the summand of larger magnitude the sum is written as
+     * `z_1 (1 + w)` with `|w| <= 1`, so only the ratio of the magnitudes is
+     * exponentiated and nothing overflows.
+     *
+     * @returns reference to this ComplexLogVal.
+     */
+    auto operator+=(const ComplexLogVal &rhs) -> ComplexLogVal & {
+        if (rhs.is_zero()) {
+            return *this;
+        }
+        if (is_zero()) {
+            *this = rhs;
+            return *this;
+        }
+
+        const bool this_larger = this->log_abs_ >= rhs.log_abs_;
+        const ComplexLogVal &larger = this_larger ? *this : rhs;
+        const ComplexLogVal &smaller = this_larger ? rhs : *this;
+
+        const T ratio = std::exp(smaller.log_abs_ - larger.log_abs_);
+        const T delta = smaller.phase_ - larger.phase_;
+        const T w_real = ratio * std::cos(delta);
+        const T w_imag = ratio * std::sin(delta);
+
+        // |1 + w|^2 = 1 + 2 Re(w) + |w|^2, log1p is accurate for small w.
+        const T log_abs =
+            ratio < T(0.5)
+                ? T(0.5) * std::log1p(T(2) * w_real + ratio * ratio)
+                : std::log(std::hypot(T(1) + w_real, w_imag));
+        if (log_abs == -std::numeric_limits<T>::infinity()) {
+            *this = ComplexLogVal();
+            return *this;
+        }
+
+        const T phase = std::atan2(w_imag, T(1) + w_real);
+        const T new_log = larger.log_abs_ + log_abs;
+        const T new_phase = wrap(larger.phase_ + phase);
+        this->log_abs_ = new_log;
+        this->phase_ = new_phase;
+
+        return *this;
+    }
+
+    auto operator-=(const ComplexLogVal &rhs) -> ComplexLogVal & {
+        // The phase of `-rhs` is rounded, so cancel identical values here.
+        if (*this == rhs) {
+            *this = ComplexLogVal();
+            return *this;
+        }
+        return *this += -rhs;
+    }
+
+    [[nodiscard]] auto operator-() const noexcept -> ComplexLogVal {
+        if (is_zero()) {
+            return *this;
+        }
+        return from_log(this->log_abs_, this->phase_ + std::numbers::pi_v<T>);
+    }
+
+    [[nodiscard]] auto operator+() const noexcept -> ComplexLogVal {
+        return *this;
+    }
+
+    /**
+     * Test if `rhs` is equal to this ComplexLogVal.
+     *
+     * @returns `true` if magnitude and phase are identical.
+     */
+    [[nodiscard]] auto operator==(const ComplexLogVal &rhs) const noexcept
+        -> bool {
+        return this->log_abs_ == rhs.log_abs_ && this->phase_ == rhs.phase_;
+    }
+
+   private:
+    /** Map `phase` into (-pi, pi]. */
+    [[nodiscard]] static auto wrap(T phase) noexcept -> T {
+        constexpr T pi = std::numbers::pi_v<T>;
+        if (phase > pi || phase <= -pi) {
+            phase = std::remainder(phase, 2 * pi);
+            if (phase <= -pi) {
+                phase += 2 * pi;
+            }
+        }
+        return phase;
+    }
+
+    [[nodiscard]] auto part(T factor) const -> LogVal<T> {
+        if (is_zero() || factor == T(0)) {
+            return LogVal<T>(T(0));
+        }
+        return LogVal<T>::from_log(this->log_abs_ + std::log(std::abs(factor)),
+                                   factor > T(0) ? LogVal<T>::Sign::positive
+                                                 : LogVal<T>::Sign::negative);
+    }
+
+    T log_abs_ = -std::numeric_limits<T>::infinity();
+    T phase_ = T(0);
+};
+
+template <typename T>
+[[nodiscard]] auto operator*(ComplexLogVal<T> lhs,
+                             const ComplexLogVal<T> &rhs) noexcept
+    -> ComplexLogVal<T> {
+    return lhs *= rhs;
+}
+
+template <typename T>
+[[nodiscard]] auto operator/(ComplexLogVal<T> lhs,
+                             const ComplexLogVal<T> &rhs) noexcept
+    -> ComplexLogVal<T> {
+    return lhs /= rhs;
+}
+
+template <typename T>
+[[nodiscard]] auto operator+(ComplexLogVal<T> lhs, const ComplexLogVal<T> &rhs)
+    -> ComplexLogVal<T> {
+    return lhs += rhs;
+}
+
+template <typename T>
+[[nodiscard]] auto operator-(ComplexLogVal<T> lhs, const ComplexLogVal<T> &rhs)
+    -> ComplexLogVal<T> {
+    return lhs -= rhs;
+}
+
+// only for debugging for now
+template <typename T>
+auto operator<<(std::ostream &os, const ComplexLogVal<T> &rhs)
+    -> std::ostream & {
+    os << "ComplexLogVal(" << rhs.log_abs() << ", " << rhs.phase() << ")";
+    return os;
+}
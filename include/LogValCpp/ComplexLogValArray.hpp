@@ -0,0 +1,225 @@
+#pragma once
+
+#include <LogValCpp/ComplexLogVal.hpp>
+#include <LogValCpp/detail/AlignedAllocator.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <vector>
+
+/**
+ * Container of ComplexLogVals using a structure-of-arrays layout.
+ *
+ * Logarithms of the magnitudes and phases are stored in separate,
+ * cache-line aligned arrays, so element wise multiplications are two
+ * vectorizable additions.
+ */
+template <typename T = double>
+    requires std::floating_point<T>
+class ComplexLogValArray {
+   public:
+    using value_type = ComplexLogVal<T>;
+    using size_type = std::size_t;
+
+    /** Alignment in bytes of the logarithm and phase arrays. */
+    static constexpr std::size_t alignment = 64;
+
+    ComplexLogValArray() = default;
+
+    explicit ComplexLogValArray(size_type count,
+                                ComplexLogVal<T> value = ComplexLogVal<T>())
+        : log_abs_(count, value.log_abs()), phases_(count, value.phase()) {}
+
+    /**
+     * Convert a batch of `std::complex<T>`.
+     */
+    explicit ComplexLogValArray(std::span<const std::complex<T>> values)
+        : log_abs_(values.size()), phases_(values.size()) {
+        for (size_type i = 0; i < values.size(); ++i) {
+            set(i, ComplexLogVal<T>(values[i]));
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return log_abs_.size();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return log_abs_.empty();
+    }
+
+    [[nodiscard]] auto get(size_type index) const -> ComplexLogVal<T> {
+        return ComplexLogVal<T>::from_log(log_abs_[index], phases_[index]);
+    }
+
+    [[nodiscard]] auto operator[](size_type index) const -> ComplexLogVal<T> {
+        return get(index);
+    }
+
+    void set(size_type index, ComplexLogVal<T> value) {
+        log_abs_[index] = value.log_abs();
+        phases_[index] = value.phase();
+    }
+
+    void push_back(ComplexLogVal<T> value) {
+        log_abs_.push_back(value.log_abs());
+        phases_.push_back(value.phase());
+    }
+
+    /**
+     * Contiguous logarithms of the magnitudes, `-inf` stores zero.
+     */
+    [[nodiscard]] auto log_abs() noexcept -> std::span<T> { return log_abs_; }
+
+    [[nodiscard]] auto log_abs() const noexcept -> std::span<const T> {
+        return log_abs_;
+    }
+
+    /**
+     * Contiguous phases, writing any finite value is allowed, reading an
+     * element and the arithmetic operators wrap them into (-pi, pi].
+     */
+    [[nodiscard]] auto phases() noexcept -> std::span<T> { return phases_; }
+
+    [[nodiscard]] auto phases() const noexcept -> std::span<const T> {
+        return phases_;
+    }
+
+    /**
+     * Convert all elements into `std::complex<T>`.
+     */
+    [[nodiscard]] auto to() const -> std::vector<std::complex<T>> {
+        std::vector<std::complex<T>> res(size());
+        for (size_type i = 0; i < size(); ++i) {
+            res[i] = std::polar(std::exp(log_abs_[i]), phases_[i]);
+        }
+        return res;
+    }
+
+    /**
+     * Multiply every element with `rhs`.
+     */
+    auto operator*=(const ComplexLogVal<T> &rhs) -> ComplexLogValArray & {
+        for (size_type i = 0; i < size(); ++i) {
+            log_abs_[i] += rhs.log_abs();
+            phases_[i] += rhs.phase();
+        }
+        wrap_phases();
+        return *this;
+    }
+
+    /**
+     * Multiply element wise with `rhs`, which needs the same size.
+     */
+    auto operator*=(const ComplexLogValArray &rhs) -> ComplexLogValArray & {
+        for (size_type i = 0; i < size(); ++i) {
+            log_abs_[i] += rhs.log_abs_[i];
+            phases_[i] += rhs.phases_[i];
+        }
+        wrap_phases();
+        return *this;
+    }
+
+    /**
+     * Divide element wise by `rhs`, which needs the same size.
+     */
+    auto operator/=(const ComplexLogValArray &rhs) -> ComplexLogValArray & {
+        for (size_type i = 0; i < size(); ++i) {
+            // Zero stays zero also for 0 / 0, like for ComplexLogVal. The
+            // select depends on the quotient, so it is not moved into a
+            // branch, which would stop the vectorization.
+            const T log_abs = log_abs_[i];
+            const T quotient = log_abs - rhs.log_abs_[i];
+            log_abs_[i] = std::isnan(quotient) &&
+                                  log_abs == -std::numeric_limits<T>::infinity()
+                              ? log_abs
+                              : quotient;
+            phases_[i] -= rhs.phases_[i];
+        }
+        wrap_phases();
+        return *this;
+    }
+
+   private:
+    /**
+     * Map all phases back into (-pi, pi] and reset the phase of zeros.
+     *
+     * The first loop shifts by 2 pi at most once and is written with quiet
+     * comparisons and selects of constants only, so it vectorizes although
+     * floating point operations may trap (on x86 from SSE4.1 on). That covers
+     * the results of the operators on wrapped phases, phases written through
+     * `phases()` further out take a second pass with `std::remainder`.
+     */
+    void wrap_phases() {
+        constexpr T pi = std::numbers::pi_v<T>;
+        size_type out_of_range = 0;
+        for (size_type i = 0; i < size(); ++i) {
+            T phase = phases_[i];
+            phase += (std::isgreater(phase, pi) ? -2 * pi : T(0)) +
+                     (std::islessequal(phase, -pi) ? 2 * pi : T(0));
+            out_of_range += std::isgreater(phase, pi) ||
+                                    std::islessequal(phase, -pi)
+                                ? 1
+                                : 0;
+            phases_[i] = log_abs_[i] == -std::numeric_limits<T>::infinity()
+                             ? T(0)
+                             : phase;
+        }
+        if (out_of_range == 0) {
+            return;
+        }
+        for (auto &phase : phases_) {
+            if (phase > pi || phase <= -pi) {
+                phase = std::remainder(phase, 2 * pi);
+                if (phase <= -pi) {
+                    phase += 2 * pi;
+                }
+            }
+        }
+    }
+
+    std::vector<T, logval::detail::AlignedAllocator<T, alignment>> log_abs_;
+    std::vector<T, logval::detail::AlignedAllocator<T, alignment>> phases_;
+};
+
+namespace logval {
+
+/**
+ * Sum all elements of `values`.
+ *
+ * The magnitudes are scaled by their maximum and summed as
+ * `std::complex<T>`, so only a single logarithm and `atan2` are needed.
+ *
+ * @returns sum of all elements, zero for an empty array.
+ */
+template <typename T>
+[[nodiscard]] auto sum(const ComplexLogValArray<T> &values)
+    -> ComplexLogVal<T> {
+    const auto logs = values.log_abs();
+    const auto phases = values.phases();
+    if (logs.empty()) {
+        return ComplexLogVal<T>();
+    }
+
+    const T max = *std::max_element(logs.begin(), logs.end());
+    if (max == -std::numeric_limits<T>::infinity()) {
+        return ComplexLogVal<T>();
+    }
+
+    std::complex<T> res(T(0));
+    for (std::size_t i = 0; i < logs.size(); ++i) {
+        res += std::polar(std::exp(logs[i] - max), phases[i]);
+    }
+    if (res == std::complex<T>(T(0))) {
+        return ComplexLogVal<T>();
+    }
+    return ComplexLogVal<T>::from_log(max + std::log(std::abs(res)),
+                                      std::arg(res));
+}
+
+}  // namespace logval
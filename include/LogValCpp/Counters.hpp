@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+
+/**
+ * Opt-in counters of LogVal operations.
+ *
+ * Compiling with `LOGVAL_ENABLE_COUNTERS` defined (CMake option of the same
+ * name) makes LogVal count per thread
+ * - additions and subtractions, i.e. calls of the policy kernels,
+ * - cancellations, subtractions of two equal values,
+ * - ignored terms, additions or subtractions of a value below the precision
+ *   of the other one, which leave it unchanged,
+ * - overflows and underflows of `to()`, conversions of finite logarithms to
+ *   infinity or zero.
+ *
+ * The counts show which loops would gain from batching (e.g. `logval::sum`)
+ * and where precision is silently lost. Without the macro nothing is counted
+ * and LogVal is unchanged. The macro has to be defined for all translation
+ * units, like `NDEBUG`.
+ *
+ * \code
+ * logval::reset_counters();
+ * run();
+ * logval::dump_counters(std::clog);
+ * \endcode
+ */
+namespace logval {
+
+/** Counts of the operations of LogVal. */
+struct Counters {
+    std::uint64_t additions = 0;
+    std::uint64_t subtractions = 0;
+    std::uint64_t cancellations = 0;
+    std::uint64_t ignored_terms = 0;
+    std::uint64_t overflows = 0;
+    std::uint64_t underflows = 0;
+
+    /** Add the counts of `other`, e.g. of another thread. */
+    auto operator+=(const Counters &other) noexcept -> Counters & {
+        this->additions += other.additions;
+        this->subtractions += other.subtractions;
+        this->cancellations += other.cancellations;
+        this->ignored_terms += other.ignored_terms;
+        this->overflows += other.overflows;
+        this->underflows += other.underflows;
+        return *this;
+    }
+
+    [[nodiscard]] auto operator==(const Counters &) const -> bool = default;
+};
+
+namespace detail {
+
+[[nodiscard]] inline auto thread_counters() noexcept -> Counters & {
+    thread_local Counters counters;
+    return counters;
+}
+
+/** Increment `counter` of this thread, nothing at compile time. */
+constexpr void count(std::uint64_t Counters::*counter) noexcept {
+    if (!std::is_constant_evaluated()) {
+        ++(thread_counters().*counter);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Counts of the calling thread since its start or the last reset.
+ */
+[[nodiscard]] inline auto counters() noexcept -> Counters {
+    return detail::thread_counters();
+}
+
+/**
+ * Reset the counts of the calling thread to zero.
+ */
+inline void reset_counters() noexcept { detail::thread_counters() = {}; }
+
+inline auto operator<<(std::ostream &os, const Counters &counters)
+    -> std::ostream & {
+    os << "additions:     " << counters.additions << '\n'
+       << "subtractions:  " << counters.subtractions << '\n'
+       << "cancellations: " << counters.cancellations << '\n'
+       << "ignored terms: " << counters.ignored_terms << '\n'
+       << "overflows:     " << counters.overflows << '\n'
+       << "underflows:    " << counters.underflows << '\n';
+    return os;
+}
+
+/**
+ * Write the counts of the calling thread to `os`.
+ */
+inline void dump_counters(std::ostream &os) { os << counters(); }
+
+}  // namespace logval
+
+#if defined(LOGVAL_ENABLE_COUNTERS)
+#define LOGVAL_COUNT(counter) \
+    ::logval::detail::count(&::logval::Counters::counter)
+#define LOGVAL_COUNT_IF(condition, counter)                            \
+    do {                                                               \
+        if (!std::is_constant_evaluated() && (condition)) {            \
+            ::logval::detail::count(&::logval::Counters::counter);     \
+        }                                                              \
+    } while (false)
+#else
+#define LOGVAL_COUNT(counter) static_cast<void>(0)
+#define LOGVAL_COUNT_IF(condition, counter) static_cast<void>(0)
+#endif
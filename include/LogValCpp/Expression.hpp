@@ -0,0 +1,294 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+/**
+ * Lazy sums and products of LogVals.
+ *
+ * With the operators of LogVal, `a * b + c * d + e` needs two additions,
+ * i.e. two `exp` and two `log1p`, each of them rounding. Starting an
+ * expression with `logval::lazy` records the operations instead:
+ * \code
+ * using logval::lazy;
+ * const LogVal<double> res = lazy(a) * b + c * d + e;
+ * \endcode
+ * On assignment (or `eval()`) the expression is expanded into a sum of
+ * products, the logarithm of every product is a plain sum, the largest
+ * term is searched and the others are summed scaled by it in linear space.
+ * Hence an expression of `n` terms needs `n - 1` calls of `exp` and a single
+ * `log1p`, a single product none at all, and there is only one rounding of
+ * the logarithm.
+ *
+ * Expressions store copies of their operands, products of sums are
+ * distributed (`a * (b + c)` has two terms).
+ */
+namespace logval {
+
+/**
+ * An expression evaluating to `logval_type` with `term_count` terms, whose
+ * (natural) logarithms and signs are visited by `for_each_term`.
+ */
+template <typename E>
+concept LogValExpression = requires(const E &expr) {
+    typename E::logval_type;
+    { E::term_count } -> std::convertible_to<std::size_t>;
+};
+
+template <LogValExpression E>
+[[nodiscard]] auto eval(const E &expr) -> typename E::logval_type;
+
+namespace detail {
+
+/**
+ * Common interface of all expressions.
+ */
+template <typename Derived, typename V>
+class ExpressionBase {
+   public:
+    using logval_type = V;
+
+    [[nodiscard]] auto eval() const -> V {
+        return logval::eval(static_cast<const Derived &>(*this));
+    }
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator V() const { return eval(); }
+
+    template <typename ToType = typename V::value_type>
+    [[nodiscard]] auto to() const -> ToType {
+        return eval().template to<ToType>();
+    }
+};
+
+}  // namespace detail
+
+/** A single LogVal. */
+template <typename V>
+class LeafExpression : public detail::ExpressionBase<LeafExpression<V>, V> {
+   public:
+    using T = typename V::value_type;
+
+    static constexpr std::size_t term_count = 1;
+
+    explicit LeafExpression(const V &val) : val_(val) {}
+
+    /** Call `f(log, is_negative)`, zero has a logarithm of `-inf`. */
+    template <typename F>
+    void for_each_term(F &&f) const {
+        if (this->val_.sign() == V::Sign::null) {
+            f(-std::numeric_limits<T>::infinity(), false);
+        } else {
+            f(detail::natural_log(this->val_),
+              this->val_.sign() == V::Sign::negative);
+        }
+    }
+
+   private:
+    V val_;
+};
+
+/** `lhs + rhs` */
+template <typename L, typename R>
+class SumExpression
+    : public detail::ExpressionBase<SumExpression<L, R>,
+                                    typename L::logval_type> {
+   public:
+    static constexpr std::size_t term_count = L::term_count + R::term_count;
+
+    SumExpression(const L &lhs, const R &rhs) : lhs_(lhs), rhs_(rhs) {}
+
+    template <typename F>
+    void for_each_term(F &&f) const {
+        this->lhs_.for_each_term(f);
+        this->rhs_.for_each_term(f);
+    }
+
+   private:
+    L lhs_;
+    R rhs_;
+};
+
+/** `lhs * rhs`, expanded into the products of all pairs of terms. */
+template <typename L, typename R>
+class ProductExpression
+    : public detail::ExpressionBase<ProductExpression<L, R>,
+                                    typename L::logval_type> {
+   public:
+    using T = typename L::logval_type::value_type;
+
+    static constexpr std::size_t term_count = L::term_count * R::term_count;
+
+    ProductExpression(const L &lhs, const R &rhs) : lhs_(lhs), rhs_(rhs) {}
+
+    template <typename F>
+    void for_each_term(F &&f) const {
+        this->lhs_.for_each_term([this, &f](T lhs_log, bool lhs_negative) {
+            this->rhs_.for_each_term(
+                [&f, lhs_log, lhs_negative](T rhs_log, bool rhs_negative) {
+                    f(lhs_log + rhs_log, lhs_negative != rhs_negative);
+                });
+        });
+    }
+
+   private:
+    L lhs_;
+    R rhs_;
+};
+
+/** `-expr` */
+template <typename E>
+class NegateExpression
+    : public detail::ExpressionBase<NegateExpression<E>,
+                                    typename E::logval_type> {
+   public:
+    using T = typename E::logval_type::value_type;
+
+    static constexpr std::size_t term_count = E::term_count;
+
+    explicit NegateExpression(const E &expr) : expr_(expr) {}
+
+    template <typename F>
+    void for_each_term(F &&f) const {
+        this->expr_.for_each_term(
+            [&f](T log, bool negative) { f(log, !negative); });
+    }
+
+   private:
+    E expr_;
+};
+
+/**
+ * Start a lazy expression with `val`.
+ */
+template <typename V>
+[[nodiscard]] auto lazy(const V &val) -> LeafExpression<V> {
+    return LeafExpression<V>(val);
+}
+
+/**
+ * Evaluate `expr` with a single logarithm.
+ *
+ * @returns value of the expression.
+ */
+template <LogValExpression E>
+[[nodiscard]] auto eval(const E &expr) -> typename E::logval_type {
+    using V = typename E::logval_type;
+    using T = typename V::value_type;
+    using Sign = typename V::Sign;
+
+    if constexpr (E::term_count == 1) {
+        // A product, no transcendental function is needed.
+        V res = V::from_log(T(0), Sign::null);
+        expr.for_each_term([&res](T log, bool negative) {
+            if (log != -std::numeric_limits<T>::infinity()) {
+                res = detail::from_natural_log<V>(
+                    log, negative ? Sign::negative : Sign::positive);
+            }
+        });
+        return res;
+    } else {
+        std::array<T, E::term_count> logs{};
+        std::array<bool, E::term_count> negative{};
+        std::size_t count = 0;
+        std::size_t lead = 0;
+        expr.for_each_term([&](T log, bool is_negative) {
+            logs[count] = log;
+            negative[count] = is_negative;
+            lead = log > logs[lead] ? count : lead;
+            ++count;
+        });
+        const T max = logs[lead];
+        if (max == -std::numeric_limits<T>::infinity()) {
+            return V::from_log(T(0), Sign::null);
+        }
+
+        // sum = lead * (1 + rest), the leading term needs no `exp`.
+        T rest = T(0);
+        for (std::size_t i = 0; i < E::term_count; ++i) {
+            const T scaled = i == lead ? T(0) : std::exp(logs[i] - max);
+            rest += negative[i] == negative[lead] ? scaled : -scaled;
+        }
+        if (rest == T(-1)) {
+            return V::from_log(T(0), Sign::null);
+        }
+        const bool is_negative = negative[lead] != (rest < T(-1));
+        const T log = rest > T(-1) ? max + std::log1p(rest)
+                                   : max + std::log(-(T(1) + rest));
+        return detail::from_natural_log<V>(
+            log, is_negative ? Sign::negative : Sign::positive);
+    }
+}
+
+namespace detail {
+
+template <typename X>
+struct expression_value {
+    using type = X;
+};
+
+template <LogValExpression X>
+struct expression_value<X> {
+    using type = typename X::logval_type;
+};
+
+/**
+ * Operands of the lazy operators: at least one expression, the other one an
+ * expression or a LogVal of the same type.
+ */
+template <typename L, typename R>
+concept expression_operands =
+    (LogValExpression<L> || LogValExpression<R>) &&
+    std::same_as<typename expression_value<L>::type,
+                 typename expression_value<R>::type>;
+
+template <typename X>
+[[nodiscard]] auto as_expression(const X &val) {
+    if constexpr (LogValExpression<X>) {
+        return val;
+    } else {
+        return LeafExpression<X>(val);
+    }
+}
+
+template <typename X>
+using as_expression_t = decltype(as_expression(std::declval<const X &>()));
+
+}  // namespace detail
+
+template <typename L, typename R>
+    requires detail::expression_operands<L, R>
+[[nodiscard]] auto operator+(const L &lhs, const R &rhs)
+    -> SumExpression<detail::as_expression_t<L>, detail::as_expression_t<R>> {
+    return {detail::as_expression(lhs), detail::as_expression(rhs)};
+}
+
+template <typename L, typename R>
+    requires detail::expression_operands<L, R>
+[[nodiscard]] auto operator-(const L &lhs, const R &rhs)
+    -> SumExpression<detail::as_expression_t<L>,
+                     NegateExpression<detail::as_expression_t<R>>> {
+    return {detail::as_expression(lhs),
+            NegateExpression<detail::as_expression_t<R>>(
+                detail::as_expression(rhs))};
+}
+
+template <typename L, typename R>
+    requires detail::expression_operands<L, R>
+[[nodiscard]] auto operator*(const L &lhs, const R &rhs)
+    -> ProductExpression<detail::as_expression_t<L>,
+                         detail::as_expression_t<R>> {
+    return {detail::as_expression(lhs), detail::as_expression(rhs)};
+}
+
+template <LogValExpression E>
+[[nodiscard]] auto operator-(const E &expr) -> NegateExpression<E> {
+    return NegateExpression<E>(expr);
+}
+
+}  // namespace logval
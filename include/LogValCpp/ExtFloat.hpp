@@ -0,0 +1,388 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+#include <utility>
+
+namespace logval::detail::ieee {
+
+/**
+ * Whether `T` is an IEEE binary32 or binary64, whose exponent can be read
+ * and set on the bits instead of calling `frexp` and `ldexp`.
+ */
+template <typename T>
+inline constexpr bool has_layout =
+    std::numeric_limits<T>::is_iec559 &&
+    (sizeof(T) == sizeof(std::uint32_t) || sizeof(T) == sizeof(std::uint64_t));
+
+template <typename T>
+using bits_type = std::conditional_t<sizeof(T) == sizeof(std::uint32_t),
+                                     std::uint32_t, std::uint64_t>;
+
+template <typename T>
+inline constexpr int mantissa_bits = std::numeric_limits<T>::digits - 1;
+
+template <typename T>
+inline constexpr int max_biased_exponent =
+    2 * std::numeric_limits<T>::max_exponent - 1;
+
+/** Biased exponent of `[0.5, 1)`, the range of `frexp`. */
+template <typename T>
+inline constexpr int half_biased_exponent =
+    std::numeric_limits<T>::max_exponent - 2;
+
+template <typename T>
+[[nodiscard]] inline auto biased_exponent(T val) noexcept -> int {
+    return static_cast<int>(
+        (std::bit_cast<bits_type<T>>(val) >> mantissa_bits<T>) &
+        static_cast<bits_type<T>>(max_biased_exponent<T>));
+}
+
+/** `val` with the biased exponent replaced by `biased`. */
+template <typename T>
+[[nodiscard]] inline auto with_biased_exponent(T val, int biased) noexcept
+    -> T {
+    using Bits = bits_type<T>;
+    constexpr Bits mask = static_cast<Bits>(max_biased_exponent<T>)
+                          << mantissa_bits<T>;
+    return std::bit_cast<T>((std::bit_cast<Bits>(val) & ~mask) |
+                            (static_cast<Bits>(biased) << mantissa_bits<T>));
+}
+
+/** `2^exponent` for exponents of normal numbers. */
+template <typename T>
+[[nodiscard]] inline auto power_of_two(int exponent) noexcept -> T {
+    return std::bit_cast<T>(
+        static_cast<bits_type<T>>(exponent + half_biased_exponent<T> + 1)
+        << mantissa_bits<T>);
+}
+
+}  // namespace logval::detail::ieee
+
+/**
+ * Represents a number as `mantissa * 2^exponent` with a 64 bit exponent.
+ *
+ * The sibling of LogVal for workloads dominated by additions: an addition
+ * aligns the exponents by a power of two and adds the mantissas, a
+ * multiplication multiplies the mantissas and adds the exponents, neither
+ * needs `exp` or `log`. The relative precision is that of `T` independently
+ * of the magnitude, whereas the precision of LogVal decreases with
+ * `|log(x)|`.
+ *
+ * The mantissa is normalized to `[0.5, 1)` like by `frexp`, which is done on
+ * the bits for `float` and `double`. Zero is stored with a zero mantissa and
+ * exponent, infinities and nans are kept in the mantissa with exponent zero.
+ * The exponent is not checked for overflow, which needs values beyond
+ * `2^(2^62)`.
+ *
+ * \code
+ * ExtFloat<double> sum;
+ * for (const auto &weight : weights) {
+ *     sum += ExtFloat<double>(weight);
+ * }
+ * const LogVal<double> res = sum.to_logval();
+ * \endcode
+ */
+template <typename T = double>
+    requires std::floating_point<T>
+class ExtFloat {
+   public:
+    using value_type = T;
+    using Sign = typename LogVal<T>::Sign;
+
+    /** Zero. */
+    ExtFloat() = default;
+
+    explicit ExtFloat(T val) noexcept { this->normalize(val, 0); }
+
+    /**
+     * Convert a LogVal, accurate to about one ulp of `T`.
+     *
+     * The logarithm is split into an integral and a fractional power of two,
+     * only the latter is rounded. Logarithms beyond the range of the exponent
+     * give infinity or zero.
+     */
+    template <typename Policy>
+    explicit ExtFloat(const LogVal<T, Policy> &val) noexcept {
+        if (val.sign() == LogVal<T, Policy>::Sign::null) {
+            return;
+        }
+        const T sign = val.sign() == LogVal<T, Policy>::Sign::negative
+                           ? T(-1)
+                           : T(1);
+        const auto [log2, log2_error] = split_log2<Policy>(val.log_abs());
+        if (!std::isfinite(log2)) {
+            this->normalize(sign * std::exp2(log2), 0);
+            return;
+        }
+        constexpr T max_exponent = T(std::int64_t{1} << 62);
+        if (std::abs(log2) >= max_exponent) {
+            this->normalize(
+                log2 > T(0) ? sign * std::numeric_limits<T>::infinity()
+                            : T(0),
+                0);
+            return;
+        }
+        const T integral = std::floor(log2);
+        // Rounded by at most half an ulp of one, for `-1 < log2 < 0`.
+        const T fraction = (log2 - integral) + log2_error;
+        this->normalize(sign * std::exp2(fraction),
+                        static_cast<std::int64_t>(integral));
+    }
+
+    /**
+     * Create an ExtFloat from `mantissa * 2^exponent`, the mantissa need not
+     * be normalized.
+     */
+    [[nodiscard]] static auto from_parts(T mantissa,
+                                         std::int64_t exponent) noexcept
+        -> ExtFloat {
+        ExtFloat res;
+        res.normalize(mantissa, exponent);
+        return res;
+    }
+
+    /**
+     * Converts this ExtFloat into `ToType` (default = `T`), which overflows
+     * to infinity or underflows to zero outside of its range.
+     */
+    template <typename ToType = T>
+    [[nodiscard]] auto to() const noexcept -> ToType {
+        constexpr std::int64_t limit = 1 << 16;
+        const auto exponent = static_cast<int>(
+            std::clamp<std::int64_t>(this->exponent_, -limit, limit));
+        return static_cast<ToType>(
+            std::ldexp(static_cast<ToType>(this->mantissa_), exponent));
+    }
+
+    /**
+     * Converts this ExtFloat into a LogVal, the logarithm is rounded once.
+     */
+    template <typename Policy = ExactMath>
+    [[nodiscard]] auto to_logval() const noexcept -> LogVal<T, Policy> {
+        using V = LogVal<T, Policy>;
+        if (this->mantissa_ == T(0)) {
+            return V::from_log(T(0), V::Sign::null);
+        }
+        const auto sign =
+            this->mantissa_ < T(0) ? V::Sign::negative : V::Sign::positive;
+        const T mantissa = std::abs(this->mantissa_);
+        const auto exponent = static_cast<T>(this->exponent_);
+        if constexpr (Policy::template ln_base<T> == std::numbers::ln2_v<T>) {
+            return V::from_log(exponent + std::log2(mantissa), sign);
+        } else {
+            return logval::detail::from_natural_log<V>(
+                std::fma(exponent, std::numbers::ln2_v<T>,
+                         std::log(mantissa)),
+                sign);
+        }
+    }
+
+    /** Mantissa, in `[0.5, 1)` in magnitude or zero. */
+    [[nodiscard]] auto mantissa() const noexcept -> T {
+        return this->mantissa_;
+    }
+
+    /** Exponent to the base two. */
+    [[nodiscard]] auto exponent() const noexcept -> std::int64_t {
+        return this->exponent_;
+    }
+
+    [[nodiscard]] auto sign() const noexcept -> Sign {
+        if (this->mantissa_ > T(0)) {
+            return Sign::positive;
+        }
+        return this->mantissa_ < T(0) ? Sign::negative : Sign::null;
+    }
+
+    auto operator*=(const ExtFloat &rhs) noexcept -> ExtFloat & {
+        this->normalize(this->mantissa_ * rhs.mantissa_,
+                        this->exponent_ + rhs.exponent_);
+        return *this;
+    }
+
+    /** Division by zero gives infinity or nan like for `T`. */
+    auto operator/=(const ExtFloat &rhs) noexcept -> ExtFloat & {
+        this->normalize(this->mantissa_ / rhs.mantissa_,
+                        this->exponent_ - rhs.exponent_);
+        return *this;
+    }
+
+    /**
+     * Adds `rhs` to this ExtFloat.
+     *
+     * The mantissa with the smaller exponent is shifted, shifts beyond the
+     * precision of `T` only leave the larger operand.
+     *
+     * @returns reference to this ExtFloat.
+     */
+    auto operator+=(const ExtFloat &rhs) noexcept -> ExtFloat & {
+        if (rhs.mantissa_ == T(0)) {
+            return *this;
+        }
+        if (this->mantissa_ == T(0)) {
+            *this = rhs;
+            return *this;
+        }
+        // Beyond `max_shift` the smaller mantissa is below half an ulp.
+        constexpr std::int64_t max_shift = std::numeric_limits<T>::digits + 2;
+        if (this->exponent_ >= rhs.exponent_) {
+            const auto shift = static_cast<int>(
+                std::min(this->exponent_ - rhs.exponent_, max_shift));
+            this->normalize(this->mantissa_ + scale(rhs.mantissa_, shift),
+                            this->exponent_);
+        } else {
+            const auto shift = static_cast<int>(
+                std::min(rhs.exponent_ - this->exponent_, max_shift));
+            this->normalize(scale(this->mantissa_, shift) + rhs.mantissa_,
+                            rhs.exponent_);
+        }
+        return *this;
+    }
+
+    auto operator-=(const ExtFloat &rhs) noexcept -> ExtFloat & {
+        return *this += -rhs;
+    }
+
+    /**
+     * Three-way comparison, by sign, exponent and mantissa.
+     */
+    [[nodiscard]] auto operator<=>(const ExtFloat &rhs) const noexcept
+        -> std::partial_ordering {
+        const T lhs_mantissa = this->mantissa_;
+        const T rhs_mantissa = rhs.mantissa_;
+        if (!std::isfinite(lhs_mantissa) || !std::isfinite(rhs_mantissa) ||
+            this->exponent_ == rhs.exponent_) {
+            return lhs_mantissa <=> rhs_mantissa;
+        }
+        const Sign lhs_sign = this->sign();
+        const Sign rhs_sign = rhs.sign();
+        if (lhs_sign != rhs_sign || lhs_sign == Sign::null) {
+            return static_cast<int>(lhs_sign) <=> static_cast<int>(rhs_sign);
+        }
+        // Normalized mantissas, the larger exponent has the larger magnitude.
+        return lhs_sign == Sign::positive ? this->exponent_ <=> rhs.exponent_
+                                          : rhs.exponent_ <=> this->exponent_;
+    }
+
+    [[nodiscard]] auto operator==(const ExtFloat &rhs) const noexcept
+        -> bool {
+        return this->mantissa_ == rhs.mantissa_ &&
+               this->exponent_ == rhs.exponent_;
+    }
+
+    auto negate() noexcept -> ExtFloat & {
+        this->mantissa_ = -this->mantissa_;
+        return *this;
+    }
+
+    [[nodiscard]] auto operator-() const noexcept -> ExtFloat {
+        return ExtFloat(*this).negate();
+    }
+
+    [[nodiscard]] auto operator+() const noexcept -> ExtFloat {
+        return *this;
+    }
+
+   private:
+    /**
+     * `log2(|x|)` from the logarithm of a LogVal, as an unevaluated sum of
+     * two values for bases other than two.
+     */
+    template <typename Policy>
+    [[nodiscard]] static auto split_log2(T log) noexcept -> std::pair<T, T> {
+        constexpr T ln_base = Policy::template ln_base<T>;
+        if constexpr (ln_base == std::numbers::ln2_v<T>) {
+            return {log, T(0)};
+        } else {
+            // log * ln_base / ln2 with the rounding error of the product.
+            const T factor = ln_base / std::numbers::ln2_v<T>;
+            const T log2 = log * factor;
+            return {log2, std::fma(log, factor, -log2)};
+        }
+    }
+
+    /** `mantissa * 2^-shift` for a normalized mantissa and a small shift. */
+    [[nodiscard]] static auto scale(T mantissa, int shift) noexcept -> T {
+        if constexpr (logval::detail::ieee::has_layout<T>) {
+            // The result stays normal, hence the product is exact.
+            return mantissa * logval::detail::ieee::power_of_two<T>(-shift);
+        } else {
+            return std::ldexp(mantissa, -shift);
+        }
+    }
+
+    void normalize(T mantissa, std::int64_t exponent) noexcept {
+        if constexpr (logval::detail::ieee::has_layout<T>) {
+            namespace ieee = logval::detail::ieee;
+            const int biased = ieee::biased_exponent(mantissa);
+            if (biased != 0 && biased != ieee::max_biased_exponent<T>)
+                [[likely]] {
+                this->mantissa_ = ieee::with_biased_exponent(
+                    mantissa, ieee::half_biased_exponent<T>);
+                this->exponent_ =
+                    exponent + (biased - ieee::half_biased_exponent<T>);
+                return;
+            }
+        }
+        // Zero, subnormal and non-finite values, or other types.
+        if (mantissa == T(0)) {
+            // Also maps -0 to 0.
+            this->mantissa_ = T(0);
+            this->exponent_ = 0;
+            return;
+        }
+        if (!std::isfinite(mantissa)) {
+            this->mantissa_ = mantissa;
+            this->exponent_ = 0;
+            return;
+        }
+        int shift = 0;
+        this->mantissa_ = std::frexp(mantissa, &shift);
+        this->exponent_ = exponent + shift;
+    }
+
+    T mantissa_ = T(0);
+    std::int64_t exponent_ = 0;
+};
+
+template <typename T>
+[[nodiscard]] auto operator*(ExtFloat<T> lhs, const ExtFloat<T> &rhs) noexcept
+    -> ExtFloat<T> {
+    return lhs *= rhs;
+}
+
+template <typename T>
+[[nodiscard]] auto operator/(ExtFloat<T> lhs, const ExtFloat<T> &rhs) noexcept
+    -> ExtFloat<T> {
+    return lhs /= rhs;
+}
+
+template <typename T>
+[[nodiscard]] auto operator+(ExtFloat<T> lhs, const ExtFloat<T> &rhs) noexcept
+    -> ExtFloat<T> {
+    return lhs += rhs;
+}
+
+template <typename T>
+[[nodiscard]] auto operator-(ExtFloat<T> lhs, const ExtFloat<T> &rhs) noexcept
+    -> ExtFloat<T> {
+    return lhs -= rhs;
+}
+
+// only for debugging, like LogVal
+template <typename T>
+auto operator<<(std::ostream &os, const ExtFloat<T> &rhs) -> std::ostream & {
+    os << "ExtFloat(" << rhs.mantissa() << " * 2^" << rhs.exponent() << ")";
+    return os;
+}
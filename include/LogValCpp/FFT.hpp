@@ -0,0 +1,512 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * Fast Fourier transforms of LogVals.
+ *
+ * The values are rescaled by their largest magnitude into complex buffers of
+ * `T`, which are transformed with an iterative radix-2 FFT (sizes which are
+ * not a power of two use Bluestein's algorithm on top of it). The common
+ * scale is kept as a logarithm next to the buffer, see ScaledComplexArray,
+ * so neither the input nor the spectrum overflow.
+ *
+ * Like every FFT, the absolute error of each output is about `epsilon` times
+ * the norm of the input, so elements which are much smaller than the largest
+ * one are not resolved.
+ */
+namespace logval::fft {
+
+/**
+ * Array of complex numbers sharing a common scale.
+ *
+ * Element `k` represents `exp(log_scale()) * mantissas()[k]`, the mantissas
+ * are normalized such that the largest absolute value of their real and
+ * imaginary parts is one.
+ */
+template <typename T = double>
+    requires std::floating_point<T>
+class ScaledComplexArray {
+   public:
+    ScaledComplexArray() = default;
+
+    /**
+     * Create the array from mantissas and the logarithm of their scale.
+     */
+    ScaledComplexArray(std::vector<std::complex<T>> mantissas, T log_scale)
+        : mantissas_(std::move(mantissas)), log_scale_(log_scale) {
+        normalize();
+    }
+
+    /**
+     * Create the array from the real LogVals in [`first`, `last`).
+     */
+    template <typename It>
+    ScaledComplexArray(It first, It last) {
+        using value_type = typename std::iterator_traits<It>::value_type;
+
+        T max = -std::numeric_limits<T>::infinity();
+        for (auto it = first; it != last; ++it) {
+            const value_type val = *it;
+            if (val.sign() != value_type::Sign::null) {
+                max = std::max(max, logval::detail::natural_log(val));
+            }
+        }
+        this->log_scale_ =
+            max == -std::numeric_limits<T>::infinity() ? T(0) : max;
+
+        for (; first != last; ++first) {
+            const value_type val = *first;
+            this->mantissas_.emplace_back(scaled_real(val, this->log_scale_));
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        return this->mantissas_.size();
+    }
+
+    [[nodiscard]] auto mantissas() noexcept -> std::span<std::complex<T>> {
+        return this->mantissas_;
+    }
+
+    [[nodiscard]] auto mantissas() const noexcept
+        -> std::span<const std::complex<T>> {
+        return this->mantissas_;
+    }
+
+    /** Logarithm of the scale common to all elements. */
+    [[nodiscard]] auto log_scale() const noexcept -> T {
+        return this->log_scale_;
+    }
+
+    /** Real part of element `index`. */
+    [[nodiscard]] auto real(std::size_t index) const -> LogVal<T> {
+        return unscaled(this->mantissas_[index].real());
+    }
+
+    /** Imaginary part of element `index`. */
+    [[nodiscard]] auto imag(std::size_t index) const -> LogVal<T> {
+        return unscaled(this->mantissas_[index].imag());
+    }
+
+    /**
+     * Logarithm of the absolute value of element `index`, `-inf` for zero.
+     */
+    [[nodiscard]] auto log_abs(std::size_t index) const -> T {
+        return this->log_scale_ + std::log(std::abs(this->mantissas_[index]));
+    }
+
+    /** Phase of element `index`. */
+    [[nodiscard]] auto arg(std::size_t index) const -> T {
+        return std::arg(this->mantissas_[index]);
+    }
+
+    /**
+     * Multiply element wise with `rhs`, which needs the same size.
+     *
+     * This is the operation needed for convolutions in Fourier space.
+     */
+    auto operator*=(const ScaledComplexArray &rhs) -> ScaledComplexArray & {
+        for (std::size_t i = 0; i < this->mantissas_.size(); ++i) {
+            this->mantissas_[i] *= rhs.mantissas_[i];
+        }
+        this->log_scale_ += rhs.log_scale_;
+        normalize();
+
+        return *this;
+    }
+
+    /**
+     * Rescale the mantissas such that the largest absolute value of their
+     * real and imaginary parts is one.
+     */
+    void normalize() {
+        T max = T(0);
+        for (const auto &val : this->mantissas_) {
+            max = std::max({max, std::abs(val.real()), std::abs(val.imag())});
+        }
+        if (max == T(0)) {
+            this->log_scale_ = T(0);
+            return;
+        }
+        for (auto &val : this->mantissas_) {
+            val /= max;
+        }
+        this->log_scale_ += std::log(max);
+    }
+
+   private:
+    template <typename V>
+    [[nodiscard]] static auto scaled_real(const V &val, T log_scale) -> T {
+        switch (val.sign()) {
+            case V::Sign::positive:
+                return std::exp(logval::detail::natural_log(val) - log_scale);
+            case V::Sign::negative:
+                return -std::exp(logval::detail::natural_log(val) - log_scale);
+            default:
+                return T(0);
+        }
+    }
+
+    [[nodiscard]] auto unscaled(T mantissa) const -> LogVal<T> {
+        return LogVal<T>(mantissa) * LogVal<T>::from_log(this->log_scale_);
+    }
+
+    std::vector<std::complex<T>> mantissas_;
+    T log_scale_ = T(0);
+};
+
+namespace detail {
+
+[[nodiscard]] constexpr auto is_power_of_two(std::size_t size) noexcept
+    -> bool {
+    return size != 0 && (size & (size - 1)) == 0;
+}
+
+[[nodiscard]] constexpr auto next_power_of_two(std::size_t size) noexcept
+    -> std::size_t {
+    std::size_t res = 1;
+    while (res < size) {
+        res *= 2;
+    }
+    return res;
+}
+
+/**
+ * `exp(-2 pi i j / size)` for `j < size / 2`, or the conjugate for the
+ * inverse transform.
+ */
+template <typename T>
+[[nodiscard]] auto twiddles(std::size_t size, bool inverse)
+    -> std::vector<std::complex<T>> {
+    const T direction = inverse ? T(1) : T(-1);
+    std::vector<std::complex<T>> res(size / 2);
+    for (std::size_t j = 0; j < res.size(); ++j) {
+        res[j] = std::polar(T(1), direction * 2 * std::numbers::pi_v<T> *
+                                      static_cast<T>(j) /
+                                      static_cast<T>(size));
+    }
+    return res;
+}
+
+/**
+ * Unnormalized in-place radix-2 FFT, the size must be a power of two.
+ *
+ * The input is permuted into bit reversed order, then the butterflies of
+ * each stage run over contiguous halves, which the compiler can vectorize.
+ */
+template <typename T>
+void radix2(std::span<std::complex<T>> data, bool inverse) {
+    const std::size_t size = data.size();
+    if (size < 2) {
+        return;
+    }
+
+    for (std::size_t i = 1, j = 0; i < size; ++i) {
+        std::size_t bit = size >> 1U;
+        for (; (j & bit) != 0; bit >>= 1U) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    const auto table = twiddles<T>(size, inverse);
+    std::vector<std::complex<T>> stage(size / 2);
+    for (std::size_t len = 2; len <= size; len *= 2) {
+        const std::size_t half = len / 2;
+        const std::size_t stride = size / len;
+        // Gather the twiddles of this stage, so the inner loop is contiguous.
+        for (std::size_t j = 0; j < half; ++j) {
+            stage[j] = table[j * stride];
+        }
+        // std::complex is layout compatible with T[2]. Its operator* checks
+        // for NaN and infinity and calls into the runtime, so the products
+        // are spelled out on the real and imaginary parts.
+        const T *twiddle = reinterpret_cast<const T *>(stage.data());
+        for (std::size_t start = 0; start < size; start += len) {
+            T *lower = reinterpret_cast<T *>(data.data() + start);
+            T *upper = lower + 2 * half;
+            for (std::size_t j = 0; j < 2 * half; j += 2) {
+                const T odd_re =
+                    upper[j] * twiddle[j] - upper[j + 1] * twiddle[j + 1];
+                const T odd_im =
+                    upper[j] * twiddle[j + 1] + upper[j + 1] * twiddle[j];
+                upper[j] = lower[j] - odd_re;
+                upper[j + 1] = lower[j + 1] - odd_im;
+                lower[j] += odd_re;
+                lower[j + 1] += odd_im;
+            }
+        }
+    }
+}
+
+/**
+ * Unnormalized in-place FFT of arbitrary size using Bluestein's algorithm,
+ * which writes the transform as a convolution of power of two size.
+ */
+template <typename T>
+void bluestein(std::span<std::complex<T>> data, bool inverse) {
+    const std::size_t size = data.size();
+    const std::size_t padded = next_power_of_two(2 * size - 1);
+    const T direction = inverse ? T(-1) : T(1);
+
+    // chirp[j] = exp(i pi j^2 / size), j^2 is reduced modulo 2 size first
+    // to keep the argument accurate.
+    std::vector<std::complex<T>> chirp(size);
+    for (std::size_t j = 0; j < size; ++j) {
+        const std::size_t square = (j * j) % (2 * size);
+        chirp[j] = std::polar(T(1), direction * std::numbers::pi_v<T> *
+                                        static_cast<T>(square) /
+                                        static_cast<T>(size));
+    }
+
+    std::vector<std::complex<T>> lhs(padded);
+    std::vector<std::complex<T>> rhs(padded);
+    for (std::size_t j = 0; j < size; ++j) {
+        lhs[j] = data[j] * std::conj(chirp[j]);
+    }
+    rhs[0] = chirp[0];
+    for (std::size_t j = 1; j < size; ++j) {
+        rhs[j] = chirp[j];
+        rhs[padded - j] = chirp[j];
+    }
+
+    radix2<T>(lhs, false);
+    radix2<T>(rhs, false);
+    for (std::size_t j = 0; j < padded; ++j) {
+        lhs[j] *= rhs[j];
+    }
+    radix2<T>(lhs, true);
+
+    const T norm = T(1) / static_cast<T>(padded);
+    for (std::size_t k = 0; k < size; ++k) {
+        data[k] = lhs[k] * std::conj(chirp[k]) * norm;
+    }
+}
+
+/**
+ * Unnormalized in-place FFT of any size.
+ */
+template <typename T>
+void transform(std::span<std::complex<T>> data, bool inverse) {
+    if (is_power_of_two(data.size())) {
+        radix2(data, inverse);
+    } else if (data.size() > 1) {
+        bluestein(data, inverse);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Discrete Fourier transform `X[k] = sum_j x[j] exp(-2 pi i j k / n)`.
+ *
+ * @returns spectrum of `values`.
+ */
+template <typename T>
+[[nodiscard]] auto forward(ScaledComplexArray<T> values)
+    -> ScaledComplexArray<T> {
+    detail::transform(values.mantissas(), false);
+    values.normalize();
+    return values;
+}
+
+/**
+ * Discrete Fourier transform of the real LogVals in [`first`, `last`).
+ *
+ * @returns spectrum of the values.
+ */
+template <typename It>
+[[nodiscard]] auto forward(It first, It last) {
+    return forward(ScaledComplexArray(first, last));
+}
+
+/**
+ * Inverse discrete Fourier transform
+ * `x[j] = 1 / n sum_k X[k] exp(2 pi i j k / n)`.
+ *
+ * @returns values with the spectrum `spectrum`.
+ */
+template <typename T>
+[[nodiscard]] auto inverse(ScaledComplexArray<T> spectrum)
+    -> ScaledComplexArray<T> {
+    const std::size_t size = spectrum.size();
+    detail::transform(spectrum.mantissas(), true);
+    return ScaledComplexArray<T>(
+        {spectrum.mantissas().begin(), spectrum.mantissas().end()},
+        spectrum.log_scale() - std::log(static_cast<T>(std::max<std::size_t>(
+                                   size, 1))));
+}
+
+/**
+ * Discrete Fourier transform of the real LogVals in [`first`, `last`).
+ *
+ * Only the `n / 2 + 1` non redundant elements of the spectrum are returned.
+ * For even `n` the values are packed into a complex transform of half the
+ * size.
+ *
+ * @returns elements `0` to `n / 2` of the spectrum, an empty spectrum for an
+ * empty range.
+ */
+template <typename It>
+[[nodiscard]] auto forward_real(It first, It last) {
+    ScaledComplexArray values(first, last);
+    using T = decltype(values.log_scale());
+
+    const std::size_t size = values.size();
+    if (size == 0) {
+        return values;
+    }
+    if (size % 2 != 0) {
+        auto res = forward(std::move(values));
+        std::vector<std::complex<T>> half(res.mantissas().begin(),
+                                          res.mantissas().begin() +
+                                              static_cast<std::ptrdiff_t>(
+                                                  size / 2 + 1));
+        return ScaledComplexArray<T>(std::move(half), res.log_scale());
+    }
+
+    // z[j] = x[2 j] + i x[2 j + 1]
+    const std::size_t half = size / 2;
+    const auto real = values.mantissas();
+    std::vector<std::complex<T>> packed(half);
+    for (std::size_t j = 0; j < half; ++j) {
+        packed[j] = {real[2 * j].real(), real[2 * j + 1].real()};
+    }
+    detail::transform<T>(packed, false);
+
+    // Split Z into the transforms of the even and odd elements,
+    // E[k] = (Z[k] + conj(Z[h - k])) / 2, O[k] = (Z[k] - conj(Z[h - k])) / 2i,
+    // and combine them to X[k] = E[k] + exp(-2 pi i k / n) O[k].
+    std::vector<std::complex<T>> res(half + 1);
+    for (std::size_t k = 0; k <= half; ++k) {
+        const std::complex<T> lhs = packed[k % half];
+        const std::complex<T> rhs = std::conj(packed[(half - k) % half]);
+        const std::complex<T> even = (lhs + rhs) / T(2);
+        const std::complex<T> odd =
+            (lhs - rhs) * std::complex<T>(T(0), T(-0.5));
+        const std::complex<T> twiddle =
+            std::polar(T(1), -2 * std::numbers::pi_v<T> *
+                                 static_cast<T>(k) / static_cast<T>(size));
+        res[k] = even + twiddle * odd;
+    }
+    return ScaledComplexArray<T>(std::move(res), values.log_scale());
+}
+
+/**
+ * Inverse of `forward_real`.
+ *
+ * @param spectrum elements `0` to `size / 2` of the spectrum of real values.
+ * @param size number of real values.
+ *
+ * @returns the `size` real values with the spectrum `spectrum`.
+ */
+template <typename T>
+[[nodiscard]] auto inverse_real(const ScaledComplexArray<T> &spectrum,
+                                std::size_t size) -> LogValArray<T> {
+    const auto input = spectrum.mantissas();
+    LogValArray<T> res;
+    if (size == 0) {
+        return res;
+    }
+
+    const std::size_t half = size / 2;
+    std::vector<std::complex<T>> values;
+    if (size % 2 != 0) {
+        // Restore the full spectrum from its hermitian symmetry.
+        values.resize(size);
+        for (std::size_t k = 0; k <= half; ++k) {
+            values[k] = input[k];
+        }
+        for (std::size_t k = half + 1; k < size; ++k) {
+            values[k] = std::conj(input[size - k]);
+        }
+        detail::transform<T>(values, true);
+    } else {
+        // Reverse the split of forward_real:
+        // Z[k] = E[k] + i O[k] with E[k] = (X[k] + conj(X[h - k])) / 2 and
+        // O[k] = (X[k] - conj(X[h - k])) exp(2 pi i k / n) / 2.
+        std::vector<std::complex<T>> packed(half);
+        for (std::size_t k = 0; k < half; ++k) {
+            const std::complex<T> lhs = input[k];
+            const std::complex<T> rhs = std::conj(input[half - k]);
+            const std::complex<T> twiddle =
+                std::polar(T(1), 2 * std::numbers::pi_v<T> *
+                                     static_cast<T>(k) / static_cast<T>(size));
+            const std::complex<T> even = (lhs + rhs) / T(2);
+            const std::complex<T> odd = (lhs - rhs) * twiddle / T(2);
+            packed[k] = even + std::complex<T>(T(0), T(1)) * odd;
+        }
+        detail::transform<T>(packed, true);
+
+        values.resize(size);
+        for (std::size_t j = 0; j < half; ++j) {
+            values[2 * j] = packed[j].real();
+            values[2 * j + 1] = packed[j].imag();
+        }
+    }
+
+    // The inverse transforms of size `n` and `n / 2` miss a factor `1 / n`
+    // and `1 / (n / 2)` respectively.
+    const T norm = size % 2 != 0 ? static_cast<T>(size)
+                                 : static_cast<T>(half);
+    const auto scale = LogVal<T>::from_log(spectrum.log_scale() -
+                                           std::log(norm));
+    for (const auto &val : values) {
+        res.push_back(LogVal<T>(val.real()) * scale);
+    }
+    return res;
+}
+
+/**
+ * Linear convolution `c[k] = sum_j a[j] b[k - j]` of the real LogVals in
+ * [`first1`, `last1`) and [`first2`, `last2`), as needed e.g. to combine
+ * densities of states of independent subsystems.
+ *
+ * Costs `O(n log n)` instead of the `O(n^2)` of a direct sum.
+ *
+ * @returns the `n1 + n2 - 1` elements of the convolution, empty if one of
+ * the ranges is empty.
+ */
+template <typename It1, typename It2>
+[[nodiscard]] auto convolve(It1 first1, It1 last1, It2 first2, It2 last2) {
+    using value_type = typename std::iterator_traits<It1>::value_type;
+    using T = decltype(std::declval<value_type>().log_abs());
+
+    const auto size1 = static_cast<std::size_t>(std::distance(first1, last1));
+    const auto size2 = static_cast<std::size_t>(std::distance(first2, last2));
+    if (size1 == 0 || size2 == 0) {
+        return LogValArray<T>();
+    }
+
+    const std::size_t size = size1 + size2 - 1;
+    const std::size_t padded = detail::next_power_of_two(size);
+    std::vector<LogVal<T>> lhs(first1, last1);
+    std::vector<LogVal<T>> rhs(first2, last2);
+    lhs.resize(padded, LogVal<T>(T(0)));
+    rhs.resize(padded, LogVal<T>(T(0)));
+
+    auto spectrum = forward_real(lhs.begin(), lhs.end());
+    spectrum *= forward_real(rhs.begin(), rhs.end());
+
+    auto res = inverse_real(spectrum, padded);
+    res.resize(size);
+    return res;
+}
+
+}  // namespace logval::fft
@@ -0,0 +1,745 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+/**
+ * Text conversion of LogVals in base 10 scientific notation.
+ *
+ * The natural logarithm is split into a decimal exponent and a mantissa,
+ * e.g. `LogVal<double>::from_log(-1e6, Sign::negative)` is written as
+ * `-3.296831478088558e-434295`. Nothing is allocated and no iostreams are
+ * used, the digits are produced by `std::to_chars`.
+ *
+ * `to_chars` writes the shortest mantissa which `from_chars` reads back to
+ * the identical logarithm. Both split off `e * ln(10)` in double-double
+ * arithmetic, the logarithm of the mantissa and the change to the base of
+ * the policy are evaluated in `long double`, with `log1p` for values close
+ * to one. Thus the round trip is exact for logarithms down to about `1e-20`
+ * in magnitude (with an 80 bit or wider `long double`, otherwise it may be
+ * off by an ulp for `|log| < 3` or for other bases than `e`).
+ */
+namespace logval {
+
+namespace detail::format {
+
+/** `ln(10) = ln10_hi + ln10_lo` to about 106 bits. */
+inline constexpr double ln10_hi = 0x1.26bb1bbb55516p+1;
+inline constexpr double ln10_lo = -0x1.f48ad494ea3e9p-53;
+
+/** Working precision for the logarithm of the mantissa. */
+using wide = long double;
+
+/** Significant digits kept by the parser, the rest is below `long double`. */
+inline constexpr std::size_t max_digits = 64;
+
+/** Largest decimal exponent, beyond `exponent * ln10` is not exact. */
+inline constexpr std::int64_t max_exponent = std::int64_t{1} << 52;
+
+/**
+ * Digits after the point of a mantissa computed in `long double`, more
+ * digits are written as zeros.
+ */
+inline constexpr int max_precision =
+    std::numeric_limits<wide>::max_digits10 - 1;
+
+/**
+ * Natural logarithm of the logarithm `log` stored in a `V`. The change of
+ * base is done in `wide`, so no bits of `log` are lost.
+ */
+template <typename V>
+[[nodiscard]] auto to_natural(typename V::value_type log) -> wide {
+    using Policy = typename V::policy_type;
+    return wide(log) * Policy::template ln_base<wide>;
+}
+
+/**
+ * Logarithm stored in a `V` for the natural logarithm `ln`, rounded once.
+ */
+template <typename V>
+[[nodiscard]] auto from_natural(wide ln) -> typename V::value_type {
+    using T = typename V::value_type;
+    using Policy = typename V::policy_type;
+    return static_cast<T>(ln / Policy::template ln_base<wide>);
+}
+
+/**
+ * Whether the decimal exponent of the finite logarithm `log` stored in a
+ * `V` is below `max_exponent`, so that `split` and `from_chars` apply.
+ */
+template <typename V>
+[[nodiscard]] auto in_range(typename V::value_type log) -> bool {
+    return std::abs(to_natural<V>(log) * std::numbers::log10e_v<wide>) <
+           static_cast<wide>(max_exponent - 2);
+}
+
+/**
+ * `log - exponent * ln(10)` with the product evaluated exactly.
+ */
+[[nodiscard]] inline auto reduce(wide log, std::int64_t exponent) -> wide {
+    const auto e = static_cast<double>(exponent);
+    const double product = e * ln10_hi;
+    const double error = std::fma(e, ln10_hi, -product);
+    return ((log - product) - error) - wide(e * ln10_lo);
+}
+
+/**
+ * `exponent * ln(10) + tail` with the product evaluated exactly.
+ */
+[[nodiscard]] inline auto expand(std::int64_t exponent, wide tail) -> wide {
+    const auto e = static_cast<double>(exponent);
+    const double product = e * ln10_hi;
+    const double error = std::fma(e, ln10_hi, -product);
+    return wide(product) + (wide(error + e * ln10_lo) + tail);
+}
+
+/**
+ * `10^k` for `k >= 0`, exact up to `10^27` with an 80 bit `long double`.
+ */
+[[nodiscard]] inline auto pow10(std::size_t k) -> wide {
+    wide res = 1;
+    for (wide base = 10; k > 0; k >>= 1U, base *= base) {
+        if ((k & 1U) != 0) {
+            res *= base;
+        }
+    }
+    return res;
+}
+
+/**
+ * The fraction `0.<digits>` from its first 19 significant digits, these
+ * fit into an integer which is exact in `long double`.
+ */
+[[nodiscard]] inline auto fraction_value(const char *digits,
+                                         std::size_t count) -> wide {
+    std::size_t zeros = 0;
+    while (zeros < count && digits[zeros] == '0') {
+        ++zeros;
+    }
+    const std::size_t used = std::min<std::size_t>(count - zeros, 19);
+    std::uint64_t integer = 0;
+    for (std::size_t i = 0; i < used; ++i) {
+        integer = integer * 10 +
+                  static_cast<std::uint64_t>(digits[zeros + i] - '0');
+    }
+    const wide res = static_cast<wide>(integer) / pow10(used);
+    return zeros == 0 ? res : res / pow10(zeros);
+}
+
+/**
+ * Natural logarithm of `0.<digits> * 10^decimal`, the first digit is not
+ * zero.
+ *
+ * Values close to one are evaluated with `log1p` of their distance to one,
+ * computed in decimal, so that they keep their precision.
+ */
+[[nodiscard]] inline auto log_of_digits(const char *digits, std::size_t count,
+                                        std::int64_t decimal) -> wide {
+    if (decimal == 1 && digits[0] == '1') {
+        // 1.<rest>
+        return std::log1p(fraction_value(digits + 1, count - 1));
+    }
+    if (decimal == 0 && digits[0] >= '5') {
+        // 1 - (1 - 0.<digits>)
+        std::size_t last = count;
+        while (last > 0 && digits[last - 1] == '0') {
+            --last;
+        }
+        std::array<char, max_digits> complement{};
+        for (std::size_t i = 0; i < last; ++i) {
+            const int digit = digits[i] - '0';
+            complement[i] =
+                static_cast<char>('0' + (i + 1 == last ? 10 : 9) - digit);
+        }
+        return std::log1p(-fraction_value(complement.data(), last));
+    }
+    return expand(decimal, std::log(fraction_value(digits, count)));
+}
+
+/**
+ * Natural logarithm of the positive number `<mantissa>e<exponent>`, the
+ * mantissa consists of digits and at most one point.
+ */
+[[nodiscard]] inline auto parse_log(const char *first, const char *last,
+                                    std::int64_t exponent) -> wide {
+    // Collect the significant digits and the position of the point, digits
+    // beyond `max_digits` are below the precision of `long double`.
+    std::array<char, max_digits> digits{};
+    std::size_t count = 0;
+    std::int64_t total = 0;
+    std::int64_t point = -1;
+    std::int64_t shift = 0;
+    for (const char *it = first; it != last; ++it) {
+        if (*it == '.') {
+            point = total;
+            continue;
+        }
+        if (total == 0 && *it == '0') {
+            // Leading zeros after the point shift the exponent.
+            if (point >= 0) {
+                --shift;
+            }
+            continue;
+        }
+        if (count < max_digits) {
+            digits[count++] = *it;
+        }
+        ++total;
+    }
+    if (count == 0) {
+        return -std::numeric_limits<wide>::infinity();
+    }
+    const std::int64_t integer_digits = point >= 0 ? point : total;
+    return log_of_digits(digits.data(), count,
+                         exponent + shift + integer_digits);
+}
+
+/**
+ * Write `<mantissa>e<exponent>` of the positive number with natural
+ * logarithm `log`, with `precision` digits after the point. Digits beyond
+ * `max_precision` are zeros.
+ */
+[[nodiscard]] inline auto write_scientific(char *first, char *last,
+                                           wide mantissa,
+                                           std::int64_t exponent,
+                                           int precision)
+    -> std::to_chars_result {
+    precision = std::max(precision, 0);
+    const int digits = std::min(precision, max_precision);
+    const auto zeros = static_cast<std::size_t>(precision - digits);
+
+    // `std::to_chars` may round up to 10, which moves the exponent.
+    std::array<char, max_precision + 16> buffer{};
+    auto res = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                             mantissa, std::chars_format::scientific, digits);
+    if (res.ec != std::errc{}) {
+        return {last, res.ec};
+    }
+    const char *exp_pos = std::find(std::as_const(buffer).data(),
+                                    static_cast<const char *>(res.ptr), 'e');
+    int mantissa_exponent = 0;
+    std::from_chars(exp_pos + (exp_pos[1] == '+' ? 2 : 1), res.ptr,
+                    mantissa_exponent);
+    exponent += mantissa_exponent;
+
+    const auto length = static_cast<std::size_t>(exp_pos - buffer.data()) +
+                        (digits == 0 && zeros > 0 ? 1 : 0) + zeros;
+    if (static_cast<std::size_t>(last - first) < length + 2) {
+        return {last, std::errc::value_too_large};
+    }
+    first = std::copy(std::as_const(buffer).data(), exp_pos, first);
+    if (digits == 0 && zeros > 0) {
+        *first++ = '.';
+    }
+    first = std::fill_n(first, zeros, '0');
+    *first++ = 'e';
+    if (exponent < 0) {
+        *first++ = '-';
+        exponent = -exponent;
+    } else {
+        if (first == last) {
+            return {last, std::errc::value_too_large};
+        }
+        *first++ = '+';
+    }
+    if (exponent < 10) {
+        if (first == last) {
+            return {last, std::errc::value_too_large};
+        }
+        *first++ = '0';
+    }
+    return std::to_chars(first, last, exponent);
+}
+
+/**
+ * Mantissa in [1, 10) and decimal exponent of the natural logarithm `log`.
+ */
+struct Decimal {
+    wide mantissa;
+    std::int64_t exponent;
+};
+
+[[nodiscard]] inline auto split(wide log) -> Decimal {
+    auto exponent = static_cast<std::int64_t>(
+        std::floor(log * std::numbers::log10e_v<wide>));
+    wide rest = reduce(log, exponent);
+    // The estimate of the exponent can be off by one at the boundaries.
+    if (rest < 0.0) {
+        --exponent;
+        rest = reduce(log, exponent);
+    } else if (rest >= ln10_hi) {
+        ++exponent;
+        rest = reduce(log, exponent);
+    }
+    return {std::exp(rest), exponent};
+}
+
+/** Capacity of `Digits`, enough for logarithms down to about `1e-30`. */
+inline constexpr int max_significant = 48;
+
+/**
+ * Decimal number `d0.d1d2... * 10^exponent` with `count` digits.
+ */
+struct Digits {
+    std::array<char, max_significant> digits{};
+    int count = 0;
+    std::int64_t exponent = 0;
+};
+
+/**
+ * Natural logarithm of `digits`.
+ */
+[[nodiscard]] inline auto parse_log(const Digits &digits) -> wide {
+    return log_of_digits(digits.digits.data(),
+                         static_cast<std::size_t>(digits.count),
+                         digits.exponent + 1);
+}
+
+/** Add one unit of the last digit. */
+inline void increment(Digits &digits) {
+    for (int i = digits.count - 1; i >= 0; --i) {
+        if (digits.digits[i] != '9') {
+            ++digits.digits[i];
+            return;
+        }
+        digits.digits[i] = '0';
+    }
+    digits.digits[0] = '1';
+    ++digits.exponent;
+}
+
+/** Subtract one unit of the last digit, the unit is kept. */
+inline void decrement(Digits &digits) {
+    for (int i = digits.count - 1; i >= 0; --i) {
+        if (digits.digits[i] != '0') {
+            --digits.digits[i];
+            break;
+        }
+        digits.digits[i] = '9';
+    }
+    if (digits.digits[0] == '0' && digits.count > 1) {
+        std::copy(digits.digits.begin() + 1,
+                  digits.digits.begin() + digits.count,
+                  digits.digits.begin());
+        --digits.count;
+        --digits.exponent;
+    }
+}
+
+/**
+ * Write the decimal digits of `value`, padded with zeros to `width`.
+ */
+inline void write_padded(std::uint64_t value, int width, char *out) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+/**
+ * Significant digits of the positive number with natural logarithm `log`,
+ * 17 of them and more if `log` is close to zero.
+ *
+ * Values in [0.5, 2) are computed from `expm1`, mirroring the `log1p` paths
+ * of the parser, all others from the exponent and mantissa of `split`. The
+ * mantissa is scaled to an integer, which `long double` holds exactly.
+ */
+[[nodiscard]] inline auto significant_digits(wide log) -> Digits {
+    constexpr int precision = std::numeric_limits<double>::max_digits10;
+    Digits res;
+    if (log >= std::numbers::ln2_v<wide> || log < -std::numbers::ln2_v<wide>) {
+        const auto decimal = split(log);
+        auto integer = static_cast<std::uint64_t>(
+            std::llround(decimal.mantissa * pow10(precision - 1)));
+        res.exponent = decimal.exponent;
+        if (integer >= static_cast<std::uint64_t>(pow10(precision))) {
+            // The mantissa has been rounded up to 10.
+            integer /= 10;
+            ++res.exponent;
+        }
+        write_padded(integer, precision, res.digits.data());
+        res.count = precision;
+        return res;
+    }
+    if (log == 0.0) {
+        res.digits[res.count++] = '1';
+        return res;
+    }
+
+    // Places for at least `precision` significant digits of the fraction,
+    // the leading zeros are estimated from the binary exponent and may be
+    // one more than this.
+    const wide f = std::abs(std::expm1(log));
+    const int zeros = static_cast<int>(
+        std::floor((-std::ilogb(f) - 1) * std::numbers::ln2_v<double> /
+                   std::numbers::ln10_v<double>));
+    const int places = std::min(zeros + precision + 1, max_significant - 1);
+    std::array<char, max_significant> fraction{};
+    write_padded(
+        static_cast<std::uint64_t>(std::llround(f * pow10(
+            static_cast<std::size_t>(places)))),
+        places, fraction.data());
+
+    if (log > 0.0) {
+        // 1 + f
+        res.digits[0] = '1';
+        std::copy(fraction.begin(), fraction.begin() + places,
+                  res.digits.begin() + 1);
+        res.count = places + 1;
+        return res;
+    }
+    // 1 - f, the decimal complement of the places.
+    int borrow = 0;
+    for (int i = places - 1; i >= 0; --i) {
+        const int digit = -(fraction[i] - '0') - borrow;
+        borrow = digit < 0 ? 1 : 0;
+        res.digits[i] = static_cast<char>('0' + digit + 10 * borrow);
+    }
+    res.count = places;
+    res.exponent = -1;
+    if (borrow == 0) {
+        // All places are zero, `f` vanished in the rounding.
+        res.digits[0] = '1';
+        res.count = 1;
+        res.exponent = 0;
+    }
+    return res;
+}
+
+/**
+ * Write `digits` as `d[.ddd]e[+-]XX`, trailing zeros are dropped.
+ */
+[[nodiscard]] inline auto write_digits(char *first, char *last,
+                                       const Digits &digits)
+    -> std::to_chars_result {
+    int count = digits.count;
+    while (count > 1 && digits.digits[count - 1] == '0') {
+        --count;
+    }
+    const auto length = static_cast<std::ptrdiff_t>(count + (count > 1) + 4);
+    if (last - first < length) {
+        return {last, std::errc::value_too_large};
+    }
+    *first++ = digits.digits[0];
+    if (count > 1) {
+        *first++ = '.';
+        first = std::copy(digits.digits.begin() + 1,
+                          digits.digits.begin() + count, first);
+    }
+    *first++ = 'e';
+    *first++ = digits.exponent < 0 ? '-' : '+';
+    const std::int64_t exponent =
+        digits.exponent < 0 ? -digits.exponent : digits.exponent;
+    if (exponent < 10) {
+        *first++ = '0';
+    }
+    return std::to_chars(first, last, exponent);
+}
+
+/**
+ * Write the positive number whose logarithm in `V` is `log` with the
+ * shortest mantissa which is parsed back to the identical `log`.
+ */
+template <typename V>
+[[nodiscard]] auto write_log(char *first, char *last,
+                             typename V::value_type log)
+    -> std::to_chars_result {
+    using T = typename V::value_type;
+    using Policy = typename V::policy_type;
+    // Units of the last digit searched around the computed digits, `exp`
+    // and the reduction are off by a few ulps of the mantissa.
+    constexpr int max_steps = 32;
+
+    auto round_trips = [log](const Digits &digits) {
+        return from_natural<V>(parse_log(digits)) == log;
+    };
+
+    Digits digits = significant_digits(to_natural<V>(log));
+    if (!round_trips(digits)) {
+        Digits up = digits;
+        Digits down = digits;
+        bool found = false;
+        for (int step = 0; step < max_steps && !found; ++step) {
+            increment(up);
+            decrement(down);
+            if (round_trips(up)) {
+                digits = up;
+                found = true;
+            } else if (round_trips(down)) {
+                digits = down;
+                found = true;
+            }
+        }
+        if (!found) {
+            // `log` is too close to zero for the digits, write the closest.
+            return write_digits(first, last, digits);
+        }
+    }
+
+    // A relative change of the value by `ulp` (of the natural logarithm)
+    // changes `log` by one ulp, the digits below that are not needed.
+    // Starting one below the estimate, search the shortest prefix, rounded
+    // down or up, which still round trips.
+    const double ulp = static_cast<double>(
+        (std::nextafter(log, std::numeric_limits<T>::infinity()) - log) *
+        Policy::template ln_base<T>);
+    const auto estimate = static_cast<int>(
+        std::ceil(-std::log10(std::abs(ulp) * (digits.digits[0] - '0'))));
+    Digits shortest = digits;
+    for (int count = std::max(estimate - 1, 1); count < digits.count;
+         ++count) {
+        Digits candidate = digits;
+        candidate.count = count;
+        if (round_trips(candidate)) {
+            shortest = candidate;
+            break;
+        }
+        increment(candidate);
+        if (round_trips(candidate)) {
+            shortest = candidate;
+            break;
+        }
+    }
+    return write_digits(first, last, shortest);
+}
+
+[[nodiscard]] inline auto write_literal(char *first, char *last,
+                                        const char *text, std::size_t length)
+    -> std::to_chars_result {
+    if (static_cast<std::size_t>(last - first) < length) {
+        return {last, std::errc::value_too_large};
+    }
+    return {std::copy(text, text + length, first), std::errc{}};
+}
+
+}  // namespace detail::format
+
+/**
+ * Write `val` in base 10 scientific notation, e.g. `-2.5e+123456`.
+ *
+ * Zero is written as `0e+00`, logarithms of `+inf` and `nan` as `inf` and
+ * `nan` (with sign).
+ *
+ * Finite values whose decimal exponent reaches `2^52` in magnitude, i.e.
+ * with `|log| >= 1.04e16`, have no text which `from_chars` reads back.
+ * Nothing is written for them.
+ *
+ * @returns like `std::to_chars`, `std::errc::value_too_large` if the range
+ * is too small, `std::errc::result_out_of_range` (with `ptr == first`) if
+ * the decimal exponent is too large.
+ */
+template <typename T, typename Policy>
+    requires(std::same_as<T, float> || std::same_as<T, double>)
+[[nodiscard]] auto to_chars(char *first, char *last,
+                            const LogVal<T, Policy> &val)
+    -> std::to_chars_result {
+    using Sign = typename LogVal<T, Policy>::Sign;
+    if (val.sign() == Sign::null) {
+        return detail::format::write_literal(first, last, "0e+00", 5);
+    }
+    char *const start = first;
+    if (val.sign() == Sign::negative) {
+        if (first == last) {
+            return {last, std::errc::value_too_large};
+        }
+        *first++ = '-';
+    }
+    const T log = val.log_abs();
+    if (std::isnan(log)) {
+        return detail::format::write_literal(first, last, "nan", 3);
+    }
+    if (std::isinf(log)) {
+        return log > 0 ? detail::format::write_literal(first, last, "inf", 3)
+                       : detail::format::write_literal(first, last, "0e+00",
+                                                       5);
+    }
+    if (!detail::format::in_range<LogVal<T, Policy>>(log)) {
+        return {start, std::errc::result_out_of_range};
+    }
+    return detail::format::write_log<LogVal<T, Policy>>(first, last, log);
+}
+
+/**
+ * Write `val` with `precision` digits after the point of the mantissa,
+ * without searching for the shortest representation. Digits beyond the
+ * precision of `long double` are written as zeros.
+ */
+template <typename T, typename Policy>
+    requires(std::same_as<T, float> || std::same_as<T, double>)
+[[nodiscard]] auto to_chars(char *first, char *last,
+                            const LogVal<T, Policy> &val, int precision)
+    -> std::to_chars_result {
+    using V = LogVal<T, Policy>;
+    using Sign = typename V::Sign;
+    const T log = val.log_abs();
+    if (val.sign() == Sign::null || !std::isfinite(log) ||
+        !detail::format::in_range<V>(log)) {
+        return to_chars(first, last, val);
+    }
+    if (val.sign() == Sign::negative) {
+        if (first == last) {
+            return {last, std::errc::value_too_large};
+        }
+        *first++ = '-';
+    }
+    const auto decimal =
+        detail::format::split(detail::format::to_natural<V>(log));
+    return detail::format::write_scientific(first, last, decimal.mantissa,
+                                            decimal.exponent, precision);
+}
+
+/**
+ * Parse a number like `-3.14159e+123456` (or without exponent, `inf`, `nan`)
+ * into `val`.
+ *
+ * @returns like `std::from_chars`, `std::errc::invalid_argument` if there is
+ * no number and `std::errc::result_out_of_range` if the exponent is too
+ * large, `val` is only changed on success.
+ */
+template <typename T, typename Policy>
+    requires(std::same_as<T, float> || std::same_as<T, double>)
+auto from_chars(const char *first, const char *last, LogVal<T, Policy> &val)
+    -> std::from_chars_result {
+    using V = LogVal<T, Policy>;
+    using Sign = typename V::Sign;
+
+    const char *it = first;
+    const bool negative = it != last && *it == '-';
+    if (negative) {
+        ++it;
+    }
+    const Sign sign = negative ? Sign::negative : Sign::positive;
+
+    auto matches = [&it, last](const char *text, std::size_t length) {
+        if (static_cast<std::size_t>(last - it) < length) {
+            return false;
+        }
+        for (std::size_t i = 0; i < length; ++i) {
+            if ((it[i] | 0x20) != text[i]) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (matches("inf", 3)) {
+        val = V::from_log(std::numeric_limits<T>::infinity(), sign);
+        return {it + 3, std::errc{}};
+    }
+    if (matches("nan", 3)) {
+        val = V::from_log(std::numeric_limits<T>::quiet_NaN(), sign);
+        return {it + 3, std::errc{}};
+    }
+
+    const char *mantissa_first = it;
+    bool has_digits = false;
+    bool has_point = false;
+    bool is_zero = true;
+    for (; it != last; ++it) {
+        if (*it >= '0' && *it <= '9') {
+            has_digits = true;
+            is_zero = is_zero && *it == '0';
+        } else if (*it == '.' && !has_point) {
+            has_point = true;
+        } else {
+            break;
+        }
+    }
+    if (!has_digits) {
+        return {first, std::errc::invalid_argument};
+    }
+    const char *mantissa_last = it;
+
+    std::int64_t exponent = 0;
+    if (it != last && (*it == 'e' || *it == 'E')) {
+        const char *exp_first = it + 1;
+        if (exp_first != last && *exp_first == '+') {
+            ++exp_first;
+        }
+        const auto res = std::from_chars(exp_first, last, exponent);
+        if (res.ec == std::errc::result_out_of_range) {
+            return {res.ptr, std::errc::result_out_of_range};
+        }
+        if (res.ec == std::errc{}) {
+            it = res.ptr;
+        }
+    }
+    if (exponent >= detail::format::max_exponent ||
+        exponent <= -detail::format::max_exponent) {
+        return {it, std::errc::result_out_of_range};
+    }
+
+    if (is_zero) {
+        val = V::from_log(T(0), Sign::null);
+        return {it, std::errc{}};
+    }
+    val = V::from_log(detail::format::from_natural<V>(detail::format::parse_log(
+                          mantissa_first, mantissa_last, exponent)),
+                      sign);
+    return {it, std::errc{}};
+}
+
+}  // namespace logval
+
+#if defined(__cpp_lib_format)
+/**
+ * `std::format` support, `{}` writes the shortest exact representation,
+ * `{:.N}` a mantissa with `N` digits after the point.
+ */
+template <typename T, typename Policy>
+struct std::formatter<LogVal<T, Policy>> {
+    int precision = -1;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin();
+        if (it != ctx.end() && *it == '.') {
+            precision = 0;
+            for (++it; it != ctx.end() && *it >= '0' && *it <= '9'; ++it) {
+                precision = precision * 10 + (*it - '0');
+            }
+        }
+        if (it != ctx.end() && *it != '}') {
+            throw std::format_error("invalid format for LogVal");
+        }
+        return it;
+    }
+
+    template <typename FormatContext>
+    auto format(const LogVal<T, Policy> &val, FormatContext &ctx) const {
+        // Enough for the shortest representation and small precisions.
+        constexpr std::size_t small = 64;
+        std::array<char, small> buffer{};
+        std::vector<char> large;
+        char *first = buffer.data();
+        std::size_t size = small;
+        if (precision > logval::detail::format::max_precision) {
+            large.resize(static_cast<std::size_t>(precision) + small);
+            first = large.data();
+            size = large.size();
+        }
+        const auto res =
+            precision < 0
+                ? logval::to_chars(first, first + size, val)
+                : logval::to_chars(first, first + size, val, precision);
+        if (res.ec != std::errc{}) {
+            throw std::format_error("LogVal out of the range of the format");
+        }
+        return std::copy(static_cast<const char *>(first),
+                         static_cast<const char *>(res.ptr), ctx.out());
+    }
+};
+#endif
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <LogValCpp/Counters.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <LogValCpp/detail/ConstexprMath.hpp>
+#include <bit>
 #include <cmath>
 #include <compare>
 #include <concepts>
 #include <cstdint>
 #include <iostream>
+#include <limits>
+#include <type_traits>
 
 /** Represents a number using a logarithmic representation.
  *
@@ -13,25 +19,59 @@
  * for all operations and that additions/subtractions are more costly compared
  * to `floats` and `doubles`.
  *
+ * The base of the logarithm and the kernels used for conversions, additions
+ * and subtractions are selected by `Policy`, see `ExactMath` (default),
+ * `FastMath` and `Base2` in MathPolicy.hpp.
+ *
  * Remarks:
  * * division with 0 will lead to nan, in contrast to doubles where it could be
  * -inf, nan, inf depending on dividend
  */
-template <typename T = double>
-    requires std::floating_point<T>
+template <typename T = double, typename Policy = ExactMath>
+    requires LogValMathPolicy<Policy, T>
 class LogVal {
    public:
-    explicit LogVal(T val) {
+    /** Sign of the value represented by a LogVal. */
+    enum class Sign : int8_t {
+        positive = 1,
+        negative = -1,
+        null = 0,
+    };
+
+    using value_type = T;
+    using policy_type = Policy;
+
+    constexpr explicit LogVal(T val) {
         if (val > 0) {
             this->sign_ = Sign::positive;
-            this->log_val_ = std::log(val);
+            this->log_val_ = Policy::log(val);
         } else if (val < 0) {
             this->sign_ = Sign::negative;
-            this->log_val_ = std::log(std::abs(val));
+            this->log_val_ = Policy::log(-val);
         } else {
             this->sign_ = Sign::null;
             // done on purpose for now
-            this->log_val_ = std::log(val);
+            this->log_val_ = Policy::log(val);
+        }
+    }
+
+    /**
+     * Convert a LogVal using a different math policy.
+     *
+     * For policies with the same base the representation is identical and
+     * only the kernels used for further operations change, otherwise the
+     * logarithm is rescaled to the base of `Policy`.
+     */
+    template <typename OtherPolicy>
+        requires(!std::same_as<OtherPolicy, Policy>)
+    constexpr explicit LogVal(const LogVal<T, OtherPolicy> &other)
+        : log_val_(other.log_abs()),
+          sign_(static_cast<Sign>(static_cast<int8_t>(other.sign()))) {
+        if constexpr (OtherPolicy::template ln_base<T> !=
+                      Policy::template ln_base<T>) {
+            this->log_val_ = this->log_val_ *
+                             OtherPolicy::template ln_base<T> /
+                             Policy::template ln_base<T>;
         }
     }
 
@@ -41,9 +81,17 @@ class LogVal {
      * @returns this LogVal as `T`.
      */
     template <typename ToType = T>
-    [[nodiscard]] auto to() const noexcept -> ToType {
-        return static_cast<ToType>(static_cast<T>(this->sign_) *
-                                   std::exp(this->log_val_));
+    [[nodiscard]] constexpr auto to() const noexcept -> ToType {
+        const auto res = static_cast<ToType>(static_cast<T>(this->sign_) *
+                                             Policy::exp(this->log_val_));
+        LOGVAL_COUNT_IF(std::is_floating_point_v<ToType> &&
+                            this->sign_ != Sign::null &&
+                            std::isfinite(this->log_val_) && std::isinf(res),
+                        overflows);
+        LOGVAL_COUNT_IF(std::is_floating_point_v<ToType> &&
+                            this->sign_ != Sign::null && res == ToType(0),
+                        underflows);
+        return res;
     }
 
     /**
@@ -52,10 +100,29 @@ class LogVal {
      *
      * @returns this LogVal as is.
      */
-    [[nodiscard]] auto as_is() const noexcept -> T {
+    [[nodiscard]] constexpr auto as_is() const noexcept -> T {
         return static_cast<T>(this->sign_) * this->log_val_;
     }
 
+    /**
+     * Return the logarithm of the absolute value of this LogVal, to the base
+     * of `Policy`.
+     *
+     * @returns `log(|x|)`, which is `-inf` for zero.
+     */
+    [[nodiscard]] constexpr auto log_abs() const noexcept -> T {
+        return this->log_val_;
+    }
+
+    /**
+     * Return the sign of this LogVal.
+     *
+     * @returns `Sign::positive`, `Sign::negative` or `Sign::null`.
+     */
+    [[nodiscard]] constexpr auto sign() const noexcept -> Sign {
+        return this->sign_;
+    }
+
     /**
      * Multiplies this LogVal with `rhs`.
      *
@@ -63,14 +130,14 @@ class LogVal {
      *
      * @returns reference to this LogVal.
      */
-    auto operator*=(const LogVal rhs) noexcept -> LogVal & {
+    constexpr auto operator*=(const LogVal rhs) noexcept -> LogVal & {
         this->sign_ = as_sign(as_int(this->sign_) * as_int(rhs.sign_));
         this->log_val_ += rhs.log_val_;
 
         return *this;
     }
 
-    auto operator/=(const LogVal rhs) noexcept -> LogVal & {
+    constexpr auto operator/=(const LogVal rhs) noexcept -> LogVal & {
         // No special treatment for division with 0.0 for now.
         this->sign_ = as_sign(as_int(this->sign_) * as_int(rhs.sign_));
         this->log_val_ -= rhs.log_val_;
@@ -88,7 +155,7 @@ class LogVal {
      *
      * @returns reference to this LogVal.
      */
-    auto operator+=(const LogVal rhs) noexcept -> LogVal & {
+    constexpr auto operator+=(const LogVal rhs) noexcept -> LogVal & {
         // Adding 0 to `this` does not change this.
         if(rhs.sign_ == Sign::null){
             return *this;
@@ -119,7 +186,9 @@ class LogVal {
                 this->log_val_ = internal_subtract(rhs.log_val_, this->log_val_);
                 this->sign_ = as_sign(as_int(this->sign_) * (-1));
             } else {
+                LOGVAL_COUNT(cancellations);
                 this->sign_ = Sign::null;
+                this->log_val_ = -std::numeric_limits<T>::infinity();
             }
         }
 
@@ -137,7 +206,7 @@ class LogVal {
      *
      * @returns reference to this LogVal.
      */
-    auto operator-=(const LogVal rhs) noexcept -> LogVal & {
+    constexpr auto operator-=(const LogVal rhs) noexcept -> LogVal & {
         *this += -rhs;
 
         return *this;
@@ -146,11 +215,61 @@ class LogVal {
     /**
      * Three-way comparison of this LogVal with \p rhs.
      *
-     * @returns weak_ordering of the two LogVals.
+     * Compares sign and logarithm directly, so no conversion is needed and
+     * values outside of the range of `T` are ordered correctly.
+     *
+     * @returns partial_ordering of the two LogVals.
+     */
+    [[nodiscard]] constexpr auto operator<=>(const LogVal rhs) const noexcept
+        -> std::partial_ordering {
+        if (this->sign_ != rhs.sign_) {
+            return as_int(this->sign_) <=> as_int(rhs.sign_);
+        }
+
+        switch (this->sign_) {
+            case Sign::positive:
+                return this->log_val_ <=> rhs.log_val_;
+            case Sign::negative:
+                return rhs.log_val_ <=> this->log_val_;
+            default:
+                return std::partial_ordering::equivalent;
+        }
+    }
+
+    /**
+     * Map this LogVal to an unsigned integer preserving the order.
+     *
+     * If `a < b` then `a.order_key() <= b.order_key()`, so keys can be used
+     * for integer comparisons and radix sorting. For `double` the last bit of
+     * the logarithm is dropped, thus values whose logarithms differ only in
+     * the last bit may get the same key.
+     *
+     * @returns monotone key of this LogVal.
      */
-    [[nodiscard]] auto operator<=>(const LogVal rhs) const noexcept {
-        // TODO: remove using .to() as it undermines the idea of this class
-        return this->to() <=> rhs.to();
+    [[nodiscard]] constexpr auto order_key() const noexcept -> std::uint64_t
+        requires(sizeof(T) == sizeof(std::uint32_t) ||
+                 sizeof(T) == sizeof(std::uint64_t))
+    {
+        using Bits = std::conditional_t<sizeof(T) == sizeof(std::uint32_t),
+                                        std::uint32_t, std::uint64_t>;
+        constexpr Bits sign_bit = Bits{1} << (8 * sizeof(Bits) - 1);
+        // Three regions (negative, zero, positive) do not fit into 64 bits
+        // for a 64 bit logarithm, hence drop one bit in that case.
+        constexpr int shift = sizeof(Bits) == sizeof(std::uint64_t) ? 1 : 0;
+        constexpr std::uint64_t zero =
+            std::uint64_t{1} << (8 * sizeof(Bits) - shift);
+
+        if (this->sign_ == Sign::null) {
+            return zero;
+        }
+
+        // Map the logarithm to an unsigned integer with the same order.
+        auto bits = std::bit_cast<Bits>(this->log_val_);
+        bits = (bits & sign_bit) != 0 ? ~bits : (bits | sign_bit);
+        const std::uint64_t key = static_cast<std::uint64_t>(bits) >> shift;
+
+        return this->sign_ == Sign::positive ? zero + 1 + key
+                                             : zero - 1 - key;
     }
 
     /**
@@ -160,7 +279,8 @@ class LogVal {
      *
      * @returns `true` if both LogVals are equal, else `false`.
      */
-    [[nodiscard]] auto operator==(const LogVal rhs) const noexcept -> bool {
+    [[nodiscard]] constexpr auto operator==(const LogVal rhs) const noexcept
+        -> bool {
         if (this->sign_ == Sign::null && rhs.sign_ == Sign::null) {
             return true;
         }
@@ -168,16 +288,18 @@ class LogVal {
         return (this->sign_ == rhs.sign_) && (this->log_val_ == rhs.log_val_);
     }
 
-    auto negate() noexcept -> LogVal & {
+    constexpr auto negate() noexcept -> LogVal & {
         this->sign_ = as_sign(-1 * as_int(this->sign_));
         return *this;
     }
 
-    [[nodiscard]] auto operator-() const noexcept -> LogVal {
+    [[nodiscard]] constexpr auto operator-() const noexcept -> LogVal {
         return LogVal(*this).negate();
     }
 
-    [[nodiscard]] auto operator+() const noexcept -> LogVal { return *this; }
+    [[nodiscard]] constexpr auto operator+() const noexcept -> LogVal {
+        return *this;
+    }
 
     /**
      * Create LogVal from value which is already a logarithm
@@ -187,33 +309,53 @@ class LogVal {
      *
      * @returns a LogVal equivalent to `std::exp(log_val)`.
      */
-    [[nodiscard]] static auto from_log(T log_val) noexcept -> LogVal {
-        return LogVal(log_val, 1);
+    [[nodiscard]] static constexpr auto from_log(T log_val) noexcept -> LogVal {
+        return LogVal(log_val, Sign::positive);
     }
 
-   private:
-    explicit LogVal(T log_val, int8_t sign) : log_val_(log_val), sign_(sign) {}
+    /**
+     * Create LogVal from the logarithm of its absolute value and its sign.
+     *
+     * @param log_val logarithm of the absolute value.
+     * @param sign sign of the created LogVal, `Sign::null` creates zero
+     * independently of `log_val`.
+     *
+     * @returns a LogVal equivalent to `sign * std::exp(log_val)`.
+     */
+    [[nodiscard]] static constexpr auto from_log(T log_val, Sign sign) noexcept
+        -> LogVal {
+        if (sign == Sign::null) {
+            return LogVal(-std::numeric_limits<T>::infinity(), Sign::null);
+        }
+        return LogVal(log_val, sign);
+    }
 
-    enum class Sign : int8_t {
-        positive = 1,
-        negative = -1,
-        null = 0,
-    };
+   private:
+    constexpr explicit LogVal(T log_val, Sign sign)
+        : log_val_(log_val), sign_(sign) {}
 
-    [[nodiscard]] static auto as_int(Sign sign) -> int8_t {
+    [[nodiscard]] static constexpr auto as_int(Sign sign) -> int8_t {
         return static_cast<int8_t>(sign);
     }
 
-    [[nodiscard]] static auto as_sign(int8_t integer) -> Sign {
+    [[nodiscard]] static constexpr auto as_sign(int8_t integer) -> Sign {
         return static_cast<Sign>(integer);
     }
 
-    [[nodiscard]] static auto internal_add(T larger, T smaller) -> T {
-        return larger + std::log1p(std::exp(smaller - larger));
+    [[nodiscard]] static constexpr auto internal_add(T larger, T smaller)
+        -> T {
+        const T res = Policy::add(larger, smaller);
+        LOGVAL_COUNT(additions);
+        LOGVAL_COUNT_IF(res == larger, ignored_terms);
+        return res;
     }
 
-    [[nodiscard]] static auto internal_subtract(T larger, T smaller) -> T {
-        return larger + std::log(T(1.0) - std::exp(smaller - larger));
+    [[nodiscard]] static constexpr auto internal_subtract(T larger,
+                                                          T smaller) -> T {
+        const T res = Policy::subtract(larger, smaller);
+        LOGVAL_COUNT(subtractions);
+        LOGVAL_COUNT_IF(res == larger, ignored_terms);
+        return res;
     }
 
     T log_val_;
@@ -233,33 +375,74 @@ class LogVal {
  *
  * @returns Product of `lhs` and `rhs`.
  */
-template <typename T>
-[[nodiscard]] auto operator*(LogVal<T> lhs, const LogVal<T> &rhs) noexcept
-    -> LogVal<T> {
+template <typename T, typename Policy>
+[[nodiscard]] constexpr auto operator*(LogVal<T, Policy> lhs,
+                             const LogVal<T, Policy> &rhs) noexcept
+    -> LogVal<T, Policy> {
     return lhs *= rhs;
 }
 
-template <typename T>
-[[nodiscard]] auto operator/(LogVal<T> lhs, const LogVal<T> &rhs) noexcept
-    -> LogVal<T> {
+template <typename T, typename Policy>
+[[nodiscard]] constexpr auto operator/(LogVal<T, Policy> lhs,
+                             const LogVal<T, Policy> &rhs) noexcept
+    -> LogVal<T, Policy> {
     return lhs /= rhs;
 }
 
-template <typename T>
-[[nodiscard]] auto operator+(LogVal<T> lhs, const LogVal<T> &rhs) noexcept
-    -> LogVal<T> {
+template <typename T, typename Policy>
+[[nodiscard]] constexpr auto operator+(LogVal<T, Policy> lhs,
+                             const LogVal<T, Policy> &rhs) noexcept
+    -> LogVal<T, Policy> {
     return lhs += rhs;
 }
 
-template <typename T>
-[[nodiscard]] auto operator-(LogVal<T> lhs, const LogVal<T> &rhs) noexcept
-    -> LogVal<T> {
+template <typename T, typename Policy>
+[[nodiscard]] constexpr auto operator-(LogVal<T, Policy> lhs,
+                             const LogVal<T, Policy> &rhs) noexcept
+    -> LogVal<T, Policy> {
     return lhs -= rhs;
 }
 
+namespace logval::detail {
+
+/**
+ * Natural logarithm of the absolute value of `val` (a LogVal or a type with
+ * the same interface), independent of the base used by its policy.
+ */
+template <typename V>
+[[nodiscard]] constexpr auto natural_log(const V &val) noexcept ->
+    typename V::value_type {
+    using T = typename V::value_type;
+    using Policy = typename V::policy_type;
+    if constexpr (Policy::template ln_base<T> == T(1)) {
+        return val.log_abs();
+    } else {
+        return val.log_abs() * Policy::template ln_base<T>;
+    }
+}
+
+/**
+ * Create a LogVal of type `V` from a natural logarithm and a sign.
+ */
+template <typename V>
+[[nodiscard]] constexpr auto from_natural_log(typename V::value_type ln,
+                                              typename V::Sign sign) noexcept
+    -> V {
+    using T = typename V::value_type;
+    using Policy = typename V::policy_type;
+    if constexpr (Policy::template ln_base<T> == T(1)) {
+        return V::from_log(ln, sign);
+    } else {
+        return V::from_log(ln / Policy::template ln_base<T>, sign);
+    }
+}
+
+}  // namespace logval::detail
+
 // only for debugging for now
-template <typename T>
-auto operator<<(std::ostream &os, const LogVal<T> &rhs) -> std::ostream & {
+template <typename T, typename Policy>
+auto operator<<(std::ostream &os, const LogVal<T, Policy> &rhs)
+    -> std::ostream & {
     os << "LogVal(" << rhs.as_is() << ")";
     return os;
 }
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <cmath>
+#include <concepts>
+#include <limits>
+
+/**
+ * Streaming sum of LogVals which avoids a logarithm per addition.
+ *
+ * The accumulator stores the running maximum of the added logarithms and
+ * the sum of all added values scaled by this maximum, separately for
+ * positive and negative values:
+ * \f[
+ *   \sum_i x_i = e^{m} \left( \sum_{x_i > 0} e^{\log|x_i| - m} -
+ *                             \sum_{x_i < 0} e^{\log|x_i| - m} \right)
+ * \f]
+ * Adding a value costs a single `exp`. If the maximum changes, the partial
+ * sums are rescaled once. Only `result()` takes a logarithm, and only there
+ * positive and negative contributions cancel.
+ *
+ * Use it instead of repeated `operator+=` if many values are added between
+ * reads of the sum.
+ */
+template <typename T = double>
+    requires std::floating_point<T>
+class LogValAccumulator {
+   public:
+    LogValAccumulator() = default;
+
+    /**
+     * Add `value` to the accumulated sum.
+     *
+     * @param value summand.
+     *
+     * @returns reference to this accumulator.
+     */
+    auto add(const LogVal<T> value) noexcept -> LogValAccumulator & {
+        using Sign = typename LogVal<T>::Sign;
+
+        if (value.sign() == Sign::null) {
+            return *this;
+        }
+
+        const T log_val = value.log_abs();
+        T scaled = T(1);
+        if (log_val > this->sum_.max) {
+            // Rescale the partial sums to the new maximum.
+            const T scale = std::exp(this->sum_.max - log_val);
+            this->sum_.positive *= scale;
+            this->sum_.negative *= scale;
+            this->sum_.max = log_val;
+        } else {
+            scaled = std::exp(log_val - this->sum_.max);
+        }
+
+        if (value.sign() == Sign::positive) {
+            this->sum_.positive += scaled;
+        } else {
+            this->sum_.negative += scaled;
+        }
+
+        return *this;
+    }
+
+    /**
+     * Add all LogVals in [`first`, `last`) to the accumulated sum.
+     *
+     * Uses the blocked kernel of `logval::sum`.
+     *
+     * @returns reference to this accumulator.
+     */
+    template <typename It>
+    auto add(It first, It last) -> LogValAccumulator & {
+        this->sum_.merge(logval::detail::scaled_sum(first, last));
+        return *this;
+    }
+
+    /**
+     * Add all elements of `values` to the accumulated sum.
+     *
+     * @returns reference to this accumulator.
+     */
+    template <typename Storage>
+    auto add(const LogValArray<T, Storage> &values) -> LogValAccumulator & {
+        this->sum_.merge(logval::detail::scaled_sum(values));
+        return *this;
+    }
+
+    auto operator+=(const LogVal<T> value) noexcept -> LogValAccumulator & {
+        return add(value);
+    }
+
+    auto operator-=(const LogVal<T> value) noexcept -> LogValAccumulator & {
+        return add(-value);
+    }
+
+    /**
+     * Add the sum accumulated by `other` to this accumulator.
+     *
+     * Useful to combine accumulators filled by different threads.
+     *
+     * @returns reference to this accumulator.
+     */
+    auto merge(const LogValAccumulator &other) noexcept
+        -> LogValAccumulator & {
+        this->sum_.merge(other.sum_);
+        return *this;
+    }
+
+    /**
+     * Return the accumulated sum.
+     *
+     * This is the only operation taking a logarithm.
+     *
+     * @returns sum of all added values, zero if nothing was added.
+     */
+    [[nodiscard]] auto result() const noexcept -> LogVal<T> {
+        return this->sum_.result();
+    }
+
+    /**
+     * Reset the accumulated sum to zero.
+     */
+    void reset() noexcept { this->sum_ = {}; }
+
+   private:
+    logval::detail::ScaledSum<T> sum_;
+};
@@ -0,0 +1,585 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/detail/AlignedAllocator.hpp>
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Container of LogVals using a structure-of-arrays layout.
+ *
+ * A `std::vector<LogVal<double>>` needs 16 bytes per element because the sign
+ * is padded to the alignment of the logarithm. This container stores the
+ * logarithms of the absolute values in one contiguous, cache-line aligned
+ * array and the signs in a separate bitset (one bit per element). Zero is
+ * stored as a logarithm of `-inf`, independent of its sign bit.
+ *
+ * Elements are accessed through proxies which behave like LogVals, so the
+ * container can be used with the usual algorithms (`std::accumulate`,
+ * `std::transform`, `std::sort`, ...). Loops which only touch the
+ * logarithms can use `logs()` directly and are easy to vectorize.
+ *
+ * The logarithms may be stored with less precision than they are computed
+ * with: `LogValArray<double, float>` stores `float` logarithms (about 4
+ * bytes per element instead of 16 for `std::vector<LogVal<double>>`), while
+ * elements are read as `LogVal<double>` and all arithmetic is done in
+ * `double`. With C++23 `std::float16_t` and `std::bfloat16_t` can be used as
+ * `Storage` as well. Stored logarithms are rounded to `Storage`, i.e. the
+ * relative error of a value is about `|log| * epsilon<Storage>`.
+ */
+template <typename T = double, typename Storage = T>
+    requires std::floating_point<T> && std::floating_point<Storage>
+class LogValArray {
+   public:
+    using value_type = LogVal<T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = LogVal<T>;
+    using storage_type = Storage;
+
+    /** Alignment in bytes of the logarithm array. */
+    static constexpr std::size_t alignment = 64;
+
+    /**
+     * Proxy referencing a single element of a LogValArray.
+     *
+     * Reading converts to a LogVal, writing stores logarithm and sign into
+     * the separate arrays.
+     */
+    class reference {
+       public:
+        reference(const reference &) = default;
+
+        ~reference() = default;
+
+        // Assignment writes the referenced value, it never rebinds the proxy.
+        auto operator=(const reference &rhs) -> reference & {
+            return *this = rhs.value();
+        }
+
+        auto operator=(const LogVal<T> rhs) -> reference & {
+            array_->set(index_, rhs);
+            return *this;
+        }
+
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        operator LogVal<T>() const { return array_->get(index_); }
+
+        /**
+         * Return the referenced element as LogVal.
+         *
+         * @returns copy of the referenced element.
+         */
+        [[nodiscard]] auto value() const -> LogVal<T> {
+            return array_->get(index_);
+        }
+
+        template <typename ToType = T>
+        [[nodiscard]] auto to() const noexcept -> ToType {
+            return value().template to<ToType>();
+        }
+
+        [[nodiscard]] auto as_is() const noexcept -> T {
+            return value().as_is();
+        }
+
+        [[nodiscard]] auto log_abs() const noexcept -> T {
+            return value().log_abs();
+        }
+
+        [[nodiscard]] auto sign() const noexcept -> typename LogVal<T>::Sign {
+            return value().sign();
+        }
+
+        auto operator*=(const LogVal<T> rhs) -> reference & {
+            return *this = value() * rhs;
+        }
+
+        auto operator/=(const LogVal<T> rhs) -> reference & {
+            return *this = value() / rhs;
+        }
+
+        auto operator+=(const LogVal<T> rhs) -> reference & {
+            return *this = value() + rhs;
+        }
+
+        auto operator-=(const LogVal<T> rhs) -> reference & {
+            return *this = value() - rhs;
+        }
+
+        auto negate() -> reference & { return *this = -value(); }
+
+        [[nodiscard]] auto operator-() const -> LogVal<T> { return -value(); }
+
+        [[nodiscard]] auto operator+() const -> LogVal<T> { return value(); }
+
+        friend void swap(reference lhs, reference rhs) {
+            const LogVal<T> tmp = lhs.value();
+            lhs = rhs.value();
+            rhs = tmp;
+        }
+
+        [[nodiscard]] friend auto operator==(const reference &lhs,
+                                             const reference &rhs) -> bool {
+            return lhs.value() == rhs.value();
+        }
+
+        [[nodiscard]] friend auto operator==(const reference &lhs,
+                                             const LogVal<T> &rhs) -> bool {
+            return lhs.value() == rhs;
+        }
+
+        [[nodiscard]] friend auto operator<=>(const reference &lhs,
+                                              const reference &rhs) {
+            return lhs.value() <=> rhs.value();
+        }
+
+        [[nodiscard]] friend auto operator<=>(const reference &lhs,
+                                              const LogVal<T> &rhs) {
+            return lhs.value() <=> rhs;
+        }
+
+        [[nodiscard]] friend auto operator*(const reference &lhs,
+                                            const reference &rhs)
+            -> LogVal<T> {
+            return lhs.value() * rhs.value();
+        }
+
+        [[nodiscard]] friend auto operator*(const reference &lhs,
+                                            const LogVal<T> &rhs)
+            -> LogVal<T> {
+            return lhs.value() * rhs;
+        }
+
+        [[nodiscard]] friend auto operator*(const LogVal<T> &lhs,
+                                            const reference &rhs)
+            -> LogVal<T> {
+            return lhs * rhs.value();
+        }
+
+        [[nodiscard]] friend auto operator/(const reference &lhs,
+                                            const reference &rhs)
+            -> LogVal<T> {
+            return lhs.value() / rhs.value();
+        }
+
+        [[nodiscard]] friend auto operator/(const reference &lhs,
+                                            const LogVal<T> &rhs)
+            -> LogVal<T> {
+            return lhs.value() / rhs;
+        }
+
+        [[nodiscard]] friend auto operator/(const LogVal<T> &lhs,
+                                            const reference &rhs)
+            -> LogVal<T> {
+            return lhs / rhs.value();
+        }
+
+        [[nodiscard]] friend auto operator+(const reference &lhs,
+                                            const reference &rhs)
+            -> LogVal<T> {
+            return lhs.value() + rhs.value();
+        }
+
+        [[nodiscard]] friend auto operator+(const reference &lhs,
+                                            const LogVal<T> &rhs)
+            -> LogVal<T> {
+            return lhs.value() + rhs;
+        }
+
+        [[nodiscard]] friend auto operator+(const LogVal<T> &lhs,
+                                            const reference &rhs)
+            -> LogVal<T> {
+            return lhs + rhs.value();
+        }
+
+        [[nodiscard]] friend auto operator-(const reference &lhs,
+                                            const reference &rhs)
+            -> LogVal<T> {
+            return lhs.value() - rhs.value();
+        }
+
+        [[nodiscard]] friend auto operator-(const reference &lhs,
+                                            const LogVal<T> &rhs)
+            -> LogVal<T> {
+            return lhs.value() - rhs;
+        }
+
+        [[nodiscard]] friend auto operator-(const LogVal<T> &lhs,
+                                            const reference &rhs)
+            -> LogVal<T> {
+            return lhs - rhs.value();
+        }
+
+       private:
+        friend class LogValArray;
+
+        reference(LogValArray *array, size_type index)
+            : array_(array), index_(index) {}
+
+        LogValArray *array_;
+        size_type index_;
+    };
+
+    /** Random access iterator yielding proxies (or LogVals if `Const`). */
+    template <bool Const>
+    class basic_iterator {
+        using container_pointer =
+            std::conditional_t<Const, const LogValArray *, LogValArray *>;
+
+       public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = LogVal<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::conditional_t<Const, LogVal<T>,
+                                             typename LogValArray::reference>;
+
+        basic_iterator() = default;
+
+        // Allows the conversion from iterator to const_iterator.
+        template <bool IsConst = Const>
+            requires IsConst
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        basic_iterator(const basic_iterator<false> &other)
+            : array_(other.array_), index_(other.index_) {}
+
+        [[nodiscard]] auto operator*() const -> reference {
+            if constexpr (Const) {
+                return array_->get(index_);
+            } else {
+                return (*array_)[index_];
+            }
+        }
+
+        [[nodiscard]] auto operator[](difference_type offset) const
+            -> reference {
+            return *(*this + offset);
+        }
+
+        auto operator++() -> basic_iterator & {
+            ++index_;
+            return *this;
+        }
+
+        auto operator++(int) -> basic_iterator {
+            auto tmp = *this;
+            ++index_;
+            return tmp;
+        }
+
+        auto operator--() -> basic_iterator & {
+            --index_;
+            return *this;
+        }
+
+        auto operator--(int) -> basic_iterator {
+            auto tmp = *this;
+            --index_;
+            return tmp;
+        }
+
+        auto operator+=(difference_type offset) -> basic_iterator & {
+            index_ = static_cast<size_type>(
+                static_cast<difference_type>(index_) + offset);
+            return *this;
+        }
+
+        auto operator-=(difference_type offset) -> basic_iterator & {
+            return *this += -offset;
+        }
+
+        [[nodiscard]] friend auto operator+(basic_iterator it,
+                                            difference_type offset)
+            -> basic_iterator {
+            return it += offset;
+        }
+
+        [[nodiscard]] friend auto operator+(difference_type offset,
+                                            basic_iterator it)
+            -> basic_iterator {
+            return it += offset;
+        }
+
+        [[nodiscard]] friend auto operator-(basic_iterator it,
+                                            difference_type offset)
+            -> basic_iterator {
+            return it -= offset;
+        }
+
+        [[nodiscard]] friend auto operator-(const basic_iterator &lhs,
+                                            const basic_iterator &rhs)
+            -> difference_type {
+            return static_cast<difference_type>(lhs.index_) -
+                   static_cast<difference_type>(rhs.index_);
+        }
+
+        [[nodiscard]] friend auto operator==(const basic_iterator &lhs,
+                                             const basic_iterator &rhs)
+            -> bool {
+            return lhs.index_ == rhs.index_;
+        }
+
+        [[nodiscard]] friend auto operator<=>(const basic_iterator &lhs,
+                                              const basic_iterator &rhs) {
+            return lhs.index_ <=> rhs.index_;
+        }
+
+       private:
+        friend class LogValArray;
+        friend class basic_iterator<true>;
+
+        basic_iterator(container_pointer array, size_type index)
+            : array_(array), index_(index) {}
+
+        container_pointer array_ = nullptr;
+        size_type index_ = 0;
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    LogValArray() = default;
+
+    /**
+     * Create an array of `count` copies of `value`.
+     *
+     * @param count number of elements.
+     * @param value value of all elements, defaults to zero.
+     */
+    explicit LogValArray(size_type count, LogVal<T> value = LogVal<T>(T(0))) {
+        resize(count, value);
+    }
+
+    LogValArray(std::initializer_list<LogVal<T>> values)
+        : LogValArray(values.begin(), values.end()) {}
+
+    /**
+     * Convert an array with a different storage type.
+     *
+     * Signs are copied word by word and logarithms in a single loop which
+     * the compiler vectorizes, so this is the bulk widening (or narrowing)
+     * kernel between storage precisions.
+     */
+    template <typename OtherStorage>
+        requires(!std::same_as<OtherStorage, Storage>)
+    explicit LogValArray(const LogValArray<T, OtherStorage> &other)
+        : logs_(other.size()),
+          signs_(other.sign_bits().begin(), other.sign_bits().end()) {
+        const auto logs = other.logs();
+        for (size_type i = 0; i < logs.size(); ++i) {
+            logs_[i] = static_cast<Storage>(logs[i]);
+        }
+    }
+
+    template <typename It>
+        requires std::convertible_to<std::iter_reference_t<It>, LogVal<T>>
+    LogValArray(It first, It last) {
+        using category = typename std::iterator_traits<It>::iterator_category;
+        if constexpr (std::derived_from<category, std::forward_iterator_tag>) {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            push_back(static_cast<LogVal<T>>(*first));
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type {
+        return logs_.size();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return logs_.empty(); }
+
+    void reserve(size_type count) {
+        logs_.reserve(count);
+        signs_.reserve(word_count(count));
+    }
+
+    void clear() noexcept {
+        logs_.clear();
+        signs_.clear();
+    }
+
+    /**
+     * Resize the array to `count` elements.
+     *
+     * @param count new number of elements.
+     * @param value value of newly added elements, defaults to zero.
+     */
+    void resize(size_type count, LogVal<T> value = LogVal<T>(T(0))) {
+        const size_type old_size = size();
+        logs_.resize(count, stored_log(value));
+        signs_.resize(word_count(count), 0);
+        for (size_type i = old_size; i < count; ++i) {
+            set_negative(i, value.sign() == LogVal<T>::Sign::negative);
+        }
+    }
+
+    void push_back(LogVal<T> value) {
+        logs_.push_back(stored_log(value));
+        if (word_count(logs_.size()) > signs_.size()) {
+            signs_.push_back(0);
+        }
+        set_negative(logs_.size() - 1,
+                     value.sign() == LogVal<T>::Sign::negative);
+    }
+
+    [[nodiscard]] auto operator[](size_type index) -> reference {
+        return reference(this, index);
+    }
+
+    [[nodiscard]] auto operator[](size_type index) const -> LogVal<T> {
+        return get(index);
+    }
+
+    /**
+     * Read the element at `index`.
+     *
+     * @returns element at `index` as LogVal.
+     */
+    [[nodiscard]] auto get(size_type index) const -> LogVal<T> {
+        const T log_val = static_cast<T>(logs_[index]);
+        if (log_val == -std::numeric_limits<T>::infinity()) {
+            return LogVal<T>::from_log(log_val, LogVal<T>::Sign::null);
+        }
+        return LogVal<T>::from_log(log_val, is_negative(index)
+                                                ? LogVal<T>::Sign::negative
+                                                : LogVal<T>::Sign::positive);
+    }
+
+    /**
+     * Overwrite the element at `index` with `value`.
+     */
+    void set(size_type index, LogVal<T> value) {
+        logs_[index] = stored_log(value);
+        set_negative(index, value.sign() == LogVal<T>::Sign::negative);
+    }
+
+    /**
+     * Test if the element at `index` is negative.
+     *
+     * @returns `true` if the sign bit of element `index` is set.
+     */
+    [[nodiscard]] auto is_negative(size_type index) const -> bool {
+        return ((signs_[index / bits_per_word] >> (index % bits_per_word)) &
+                1U) != 0;
+    }
+
+    /**
+     * Contiguous, `alignment` aligned logarithms of the absolute values.
+     *
+     * Writing to this span changes the magnitude of the elements but keeps
+     * their signs, a value of `-inf` stores zero.
+     */
+    [[nodiscard]] auto logs() noexcept -> std::span<Storage> { return logs_; }
+
+    [[nodiscard]] auto logs() const noexcept -> std::span<const Storage> {
+        return logs_;
+    }
+
+    /**
+     * Packed sign bits, bit `i % 64` of word `i / 64` is set if element `i`
+     * is negative.
+     */
+    [[nodiscard]] auto sign_bits() const noexcept
+        -> std::span<const std::uint64_t> {
+        return signs_;
+    }
+
+    /**
+     * Multiply every element with `rhs`.
+     *
+     * Only adds to the logarithm array and flips sign words, so the loop is
+     * trivially vectorizable.
+     */
+    auto operator*=(const LogVal<T> rhs) -> LogValArray & {
+        if (rhs.sign() == LogVal<T>::Sign::null) {
+            std::fill(logs_.begin(), logs_.end(),
+                      -std::numeric_limits<Storage>::infinity());
+            std::fill(signs_.begin(), signs_.end(), 0);
+            return *this;
+        }
+
+        const T log_val = rhs.log_abs();
+        for (auto &elem : logs_) {
+            elem = static_cast<Storage>(static_cast<T>(elem) + log_val);
+        }
+        if (rhs.sign() == LogVal<T>::Sign::negative) {
+            flip_signs();
+        }
+
+        return *this;
+    }
+
+    auto operator/=(const LogVal<T> rhs) -> LogValArray & {
+        // No special treatment for division with 0.0, like LogVal.
+        const T log_val = rhs.log_abs();
+        for (auto &elem : logs_) {
+            elem = static_cast<Storage>(static_cast<T>(elem) - log_val);
+        }
+        if (rhs.sign() == LogVal<T>::Sign::negative) {
+            flip_signs();
+        }
+
+        return *this;
+    }
+
+    [[nodiscard]] auto begin() noexcept -> iterator { return {this, 0}; }
+    [[nodiscard]] auto end() noexcept -> iterator { return {this, size()}; }
+    [[nodiscard]] auto begin() const noexcept -> const_iterator {
+        return {this, 0};
+    }
+    [[nodiscard]] auto end() const noexcept -> const_iterator {
+        return {this, size()};
+    }
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+        return begin();
+    }
+    [[nodiscard]] auto cend() const noexcept -> const_iterator {
+        return end();
+    }
+
+   private:
+    static constexpr size_type bits_per_word = 64;
+
+    [[nodiscard]] static auto word_count(size_type count) -> size_type {
+        return (count + bits_per_word - 1) / bits_per_word;
+    }
+
+    [[nodiscard]] static auto stored_log(LogVal<T> value) -> Storage {
+        if (value.sign() == LogVal<T>::Sign::null) {
+            return -std::numeric_limits<Storage>::infinity();
+        }
+        return static_cast<Storage>(value.log_abs());
+    }
+
+    void set_negative(size_type index, bool negative) {
+        const std::uint64_t mask = std::uint64_t{1} << (index % bits_per_word);
+        auto &word = signs_[index / bits_per_word];
+        word = negative ? (word | mask) : (word & ~mask);
+    }
+
+    void flip_signs() {
+        for (auto &word : signs_) {
+            word = ~word;
+        }
+        // Keep the unused bits of the last word cleared.
+        if (size() % bits_per_word != 0) {
+            signs_.back() &=
+                (std::uint64_t{1} << (size() % bits_per_word)) - 1;
+        }
+    }
+
+    std::vector<Storage, logval::detail::AlignedAllocator<Storage, alignment>>
+        logs_;
+    std::vector<std::uint64_t> signs_;
+};
@@ -0,0 +1,556 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <LogValCpp/PackedLogVal.hpp>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LOGVALCPP_HAS_MMAP 1
+#endif
+
+/**
+ * Binary files of LogVals, written in chunks and read without parsing.
+ *
+ * File format (all integers in the byte order given by `endianness`):
+ *
+ * | offset | size | field                                                 |
+ * |--------|------|-------------------------------------------------------|
+ * | 0      | 8    | magic `"LOGVAL\0\0"`                                  |
+ * | 8      | 4    | format version, currently 1                           |
+ * | 12     | 1    | value type of the logarithms, 1 = float, 2 = double   |
+ * | 13     | 1    | endianness, 1 = little, 2 = big                       |
+ * | 14     | 1    | layout, 1 = packed, 2 = structure of arrays           |
+ * | 15     | 9    | reserved, zero                                        |
+ * | 24     | 8    | number of values                                      |
+ * | 32     | 32   | reserved, zero                                        |
+ *
+ * The data starts at offset 64 and holds natural logarithms:
+ * * packed: one PackedLogVal word per value (sign in the last bit of the
+ *   logarithm, zero as `-inf`).
+ * * structure of arrays: the logarithms (`-inf` for zero), padded with zeros
+ *   to a multiple of 64 bytes, followed by one 64 bit word per 64 values
+ *   with bit `i % 64` of word `i / 64` set if value `i` is negative, i.e.
+ *   the layout of LogValArray.
+ *
+ * Files are only read on machines with the byte order of the writer, so the
+ * data can be used in place.
+ */
+namespace logval::io {
+
+enum class Layout : std::uint8_t {
+    packed = 1,
+    soa = 2,
+};
+
+enum class ValueType : std::uint8_t {
+    float32 = 1,
+    float64 = 2,
+};
+
+enum class Endianness : std::uint8_t {
+    little = 1,
+    big = 2,
+};
+
+/** The 64 byte header at the start of every file. */
+struct FileHeader {
+    std::array<char, 8> magic{'L', 'O', 'G', 'V', 'A', 'L', '\0', '\0'};
+    std::uint32_t version = 1;
+    ValueType value_type = ValueType::float64;
+    Endianness endianness = std::endian::native == std::endian::big
+                                ? Endianness::big
+                                : Endianness::little;
+    Layout layout = Layout::soa;
+    std::array<std::uint8_t, 9> reserved1{};
+    std::uint64_t count = 0;
+    std::array<std::uint8_t, 32> reserved2{};
+};
+
+static_assert(sizeof(FileHeader) == 64);
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+
+/** Offset of the data and alignment of the log array in the file. */
+inline constexpr std::size_t data_alignment = 64;
+
+namespace detail {
+
+template <typename Storage>
+inline constexpr ValueType value_type_of =
+    sizeof(Storage) == sizeof(float) ? ValueType::float32 : ValueType::float64;
+
+[[nodiscard]] inline auto padded_bytes(std::size_t bytes) -> std::size_t {
+    return (bytes + data_alignment - 1) / data_alignment * data_alignment;
+}
+
+[[nodiscard]] inline auto is_valid(const FileHeader &header) -> bool {
+    const FileHeader reference;
+    return header.magic == reference.magic && header.version == 1 &&
+           header.endianness == reference.endianness &&
+           (header.value_type == ValueType::float32 ||
+            header.value_type == ValueType::float64) &&
+           (header.layout == Layout::packed || header.layout == Layout::soa);
+}
+
+/** Number of bytes following the header. */
+template <typename Storage>
+[[nodiscard]] auto data_bytes(Layout layout, std::uint64_t count)
+    -> std::size_t {
+    if (layout == Layout::packed) {
+        return count * sizeof(Storage);
+    }
+    return padded_bytes(count * sizeof(Storage)) +
+           (count + 63) / 64 * sizeof(std::uint64_t);
+}
+
+/**
+ * Whether `count` values in `layout` fit into the `available` bytes after
+ * the header. The count is bounded before `data_bytes` multiplies it, so a
+ * corrupt count can not wrap around to a small size.
+ */
+template <typename Storage>
+[[nodiscard]] auto fits(Layout layout, std::uint64_t count,
+                        std::size_t available) -> bool {
+    return count <= available / sizeof(Storage) &&
+           data_bytes<Storage>(layout, count) <= available;
+}
+
+}  // namespace detail
+
+/**
+ * Read the header of the file at `path`.
+ *
+ * @returns the header, nothing if the file can not be read or is no LogVal
+ * file of this machine's byte order.
+ */
+[[nodiscard]] inline auto read_header(const std::filesystem::path &path)
+    -> std::optional<FileHeader> {
+    std::ifstream file(path, std::ios::binary);
+    FileHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        !detail::is_valid(header)) {
+        return std::nullopt;
+    }
+    return header;
+}
+
+/**
+ * Streaming writer, values can be appended in chunks of any size.
+ *
+ * Values are buffered and written in blocks, so memory use is independent of
+ * the file size, except for the sign bits of the structure-of-arrays layout
+ * (1 bit per value) which are appended by `close()`.
+ */
+template <typename Storage = double>
+    requires(std::same_as<Storage, float> || std::same_as<Storage, double>)
+class Writer {
+   public:
+    /** Number of values buffered before they are written. */
+    static constexpr std::size_t chunk_size = std::size_t{1} << 16;
+
+    /**
+     * Create the file at `path`, an existing file is overwritten.
+     *
+     * @returns the writer, nothing if the file can not be created.
+     */
+    [[nodiscard]] static auto open(const std::filesystem::path &path,
+                                   Layout layout = Layout::soa)
+        -> std::optional<Writer> {
+        Writer writer(path, layout);
+        if (!writer.file_) {
+            return std::nullopt;
+        }
+        return writer;
+    }
+
+    Writer(Writer &&) noexcept = default;
+    auto operator=(Writer &&) noexcept -> Writer & = default;
+    Writer(const Writer &) = delete;
+    auto operator=(const Writer &) -> Writer & = delete;
+
+    ~Writer() {
+        if (this->file_.is_open()) {
+            static_cast<void>(close());
+        }
+    }
+
+    /**
+     * Append `value` of any policy, it is stored with its natural logarithm.
+     */
+    template <typename V>
+    void write(const V &value) {
+        using Sign = typename LogVal<Storage>::Sign;
+        const bool is_null = value.sign() == V::Sign::null;
+        const bool is_negative = value.sign() == V::Sign::negative;
+        const auto log = is_null ? -std::numeric_limits<Storage>::infinity()
+                                 : static_cast<Storage>(
+                                       logval::detail::natural_log(value));
+
+        if (this->layout_ == Layout::packed) {
+            this->packed_.push_back(
+                PackedLogVal<Storage>::from_log(
+                    log, is_null ? Sign::null
+                                 : (is_negative ? Sign::negative
+                                                : Sign::positive))
+                    .bits());
+        } else {
+            this->logs_.push_back(log);
+            if (this->count_ % 64 == 0) {
+                this->signs_.push_back(0);
+            }
+            if (is_negative && !is_null) {
+                this->signs_.back() |= std::uint64_t{1} << (this->count_ % 64);
+            }
+        }
+        ++this->count_;
+        if (this->logs_.size() + this->packed_.size() >= chunk_size) {
+            flush();
+        }
+    }
+
+    /** Append all LogVals in [`first`, `last`). */
+    template <typename It>
+    void write(It first, It last) {
+        for (; first != last; ++first) {
+            write(static_cast<typename std::iterator_traits<It>::value_type>(
+                *first));
+        }
+    }
+
+    /**
+     * Append all elements of `values`.
+     *
+     * If the array has the same storage type and the file is at a multiple
+     * of 64 values, logarithms and sign words are written as they are.
+     */
+    template <typename T, typename S>
+    void write(const LogValArray<T, S> &values) {
+        if constexpr (std::same_as<S, Storage>) {
+            if (this->layout_ == Layout::soa && this->count_ % 64 == 0) {
+                flush();
+                write_bytes(values.logs().data(),
+                            values.size() * sizeof(Storage));
+                this->signs_.insert(this->signs_.end(),
+                                    values.sign_bits().begin(),
+                                    values.sign_bits().end());
+                this->count_ += values.size();
+                return;
+            }
+        }
+        write(values.begin(), values.end());
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::uint64_t {
+        return this->count_;
+    }
+
+    /**
+     * Write the remaining data and the final header and close the file.
+     *
+     * @returns `true` if all data was written successfully.
+     */
+    [[nodiscard]] auto close() -> bool {
+        flush();
+        if (this->layout_ == Layout::soa) {
+            const std::size_t bytes = this->count_ * sizeof(Storage);
+            const std::vector<char> padding(detail::padded_bytes(bytes) - bytes,
+                                            0);
+            write_bytes(padding.data(), padding.size());
+            write_bytes(this->signs_.data(),
+                        this->signs_.size() * sizeof(std::uint64_t));
+        }
+
+        FileHeader header;
+        header.value_type = detail::value_type_of<Storage>;
+        header.layout = this->layout_;
+        header.count = this->count_;
+        this->file_.seekp(0);
+        write_bytes(&header, sizeof(header));
+
+        this->file_.close();
+        return !this->file_.fail();
+    }
+
+   private:
+    Writer(const std::filesystem::path &path, Layout layout)
+        : file_(path, std::ios::binary | std::ios::trunc), layout_(layout) {
+        // Placeholder, the header is written by `close()`.
+        const FileHeader header{};
+        write_bytes(&header, sizeof(header));
+        if (layout == Layout::packed) {
+            this->packed_.reserve(chunk_size);
+        } else {
+            this->logs_.reserve(chunk_size);
+        }
+    }
+
+    void write_bytes(const void *data, std::size_t bytes) {
+        this->file_.write(static_cast<const char *>(data),
+                          static_cast<std::streamsize>(bytes));
+    }
+
+    void flush() {
+        write_bytes(this->logs_.data(), this->logs_.size() * sizeof(Storage));
+        write_bytes(this->packed_.data(),
+                    this->packed_.size() * sizeof(Storage));
+        this->logs_.clear();
+        this->packed_.clear();
+    }
+
+    std::ofstream file_;
+    Layout layout_;
+    std::uint64_t count_ = 0;
+    std::vector<Storage> logs_;
+    std::vector<typename PackedLogVal<Storage>::bits_type> packed_;
+    std::vector<std::uint64_t> signs_;
+};
+
+/**
+ * Write all elements of `values` in the layout of LogValArray.
+ *
+ * @returns `true` on success.
+ */
+template <typename T, typename Storage>
+    requires(std::same_as<Storage, float> || std::same_as<Storage, double>)
+[[nodiscard]] auto write(const std::filesystem::path &path,
+                         const LogValArray<T, Storage> &values) -> bool {
+    auto writer = Writer<Storage>::open(path, Layout::soa);
+    if (!writer) {
+        return false;
+    }
+    writer->write(values);
+    return writer->close();
+}
+
+/**
+ * Write all elements of `values` in the packed layout.
+ *
+ * @returns `true` on success.
+ */
+template <typename T, typename Policy>
+[[nodiscard]] auto write(const std::filesystem::path &path,
+                         std::span<const PackedLogVal<T, Policy>> values)
+    -> bool {
+    auto writer = Writer<T>::open(path, Layout::packed);
+    if (!writer) {
+        return false;
+    }
+    writer->write(values.begin(), values.end());
+    return writer->close();
+}
+
+/**
+ * Read-only view of a LogVal file, which is memory mapped where `mmap` is
+ * available (else read into memory at once).
+ *
+ * Opening only checks the header, pages are loaded by the operating system
+ * when they are accessed, so a restart does not need to read the whole file.
+ */
+template <typename Storage = double>
+    requires(std::same_as<Storage, float> || std::same_as<Storage, double>)
+class MappedFile {
+   public:
+    /**
+     * Map the file at `path`.
+     *
+     * @returns the view, nothing if the file can not be read, is no valid
+     * LogVal file or its values are not of type `Storage`.
+     */
+    [[nodiscard]] static auto open(const std::filesystem::path &path)
+        -> std::optional<MappedFile> {
+        MappedFile res;
+        if (!res.map(path)) {
+            return std::nullopt;
+        }
+
+        std::memcpy(&res.header_, res.data_, sizeof(FileHeader));
+        if (!detail::is_valid(res.header_) ||
+            res.header_.value_type != detail::value_type_of<Storage> ||
+            !detail::fits<Storage>(res.header_.layout, res.header_.count,
+                                   res.size_ - sizeof(FileHeader))) {
+            return std::nullopt;
+        }
+        return res;
+    }
+
+    MappedFile(MappedFile &&other) noexcept
+        : header_(other.header_),
+          data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          buffer_(std::move(other.buffer_)) {}
+
+    auto operator=(MappedFile &&other) noexcept -> MappedFile & {
+        if (this != &other) {
+            unmap();
+            this->header_ = other.header_;
+            this->data_ = std::exchange(other.data_, nullptr);
+            this->size_ = std::exchange(other.size_, 0);
+            this->buffer_ = std::move(other.buffer_);
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    auto operator=(const MappedFile &) -> MappedFile & = delete;
+
+    ~MappedFile() { unmap(); }
+
+    [[nodiscard]] auto header() const noexcept -> const FileHeader & {
+        return this->header_;
+    }
+
+    [[nodiscard]] auto layout() const noexcept -> Layout {
+        return this->header_.layout;
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        return this->header_.count;
+    }
+
+    /**
+     * Values of a file in packed layout, empty for other layouts.
+     */
+    [[nodiscard]] auto packed() const noexcept
+        -> std::span<const PackedLogVal<Storage>> {
+        if (layout() != Layout::packed) {
+            return {};
+        }
+        return {reinterpret_cast<const PackedLogVal<Storage> *>(payload()),
+                size()};
+    }
+
+    /**
+     * Logarithms of a file in structure-of-arrays layout, empty for other
+     * layouts.
+     */
+    [[nodiscard]] auto logs() const noexcept -> std::span<const Storage> {
+        if (layout() != Layout::soa) {
+            return {};
+        }
+        return {reinterpret_cast<const Storage *>(payload()), size()};
+    }
+
+    /**
+     * Sign bits of a file in structure-of-arrays layout, see
+     * `LogValArray::sign_bits`.
+     */
+    [[nodiscard]] auto sign_bits() const noexcept
+        -> std::span<const std::uint64_t> {
+        if (layout() != Layout::soa) {
+            return {};
+        }
+        return {reinterpret_cast<const std::uint64_t *>(
+                    payload() + detail::padded_bytes(size() * sizeof(Storage))),
+                (size() + 63) / 64};
+    }
+
+    /**
+     * Read value `index` independent of the layout.
+     */
+    template <typename T = Storage>
+    [[nodiscard]] auto get(std::size_t index) const -> LogVal<T> {
+        using Sign = typename LogVal<T>::Sign;
+        if (layout() == Layout::packed) {
+            const auto val = packed()[index].unpack();
+            return LogVal<T>::from_log(static_cast<T>(val.log_abs()),
+                                       static_cast<Sign>(val.sign()));
+        }
+        const T log = static_cast<T>(logs()[index]);
+        if (log == -std::numeric_limits<T>::infinity()) {
+            return LogVal<T>::from_log(log, Sign::null);
+        }
+        const bool negative =
+            ((sign_bits()[index / 64] >> (index % 64)) & 1U) != 0;
+        return LogVal<T>::from_log(log,
+                                   negative ? Sign::negative : Sign::positive);
+    }
+
+    [[nodiscard]] auto operator[](std::size_t index) const -> LogVal<Storage> {
+        return get(index);
+    }
+
+   private:
+    MappedFile() = default;
+
+    [[nodiscard]] auto payload() const noexcept -> const std::byte * {
+        return this->data_ + sizeof(FileHeader);
+    }
+
+    auto map(const std::filesystem::path &path) -> bool {
+#ifdef LOGVALCPP_HAS_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 ||
+            static_cast<std::size_t>(info.st_size) < sizeof(FileHeader)) {
+            ::close(fd);
+            return false;
+        }
+        void *data = ::mmap(nullptr, static_cast<std::size_t>(info.st_size),
+                            PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        this->data_ = static_cast<const std::byte *>(data);
+        this->size_ = static_cast<std::size_t>(info.st_size);
+        return true;
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return false;
+        }
+        const auto bytes = static_cast<std::size_t>(file.tellg());
+        if (bytes < sizeof(FileHeader)) {
+            return false;
+        }
+        // 64 bit words keep the data aligned for all value types.
+        this->buffer_.resize((bytes + 7) / 8);
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char *>(this->buffer_.data()),
+                       static_cast<std::streamsize>(bytes))) {
+            return false;
+        }
+        this->data_ = reinterpret_cast<const std::byte *>(this->buffer_.data());
+        this->size_ = bytes;
+        return true;
+#endif
+    }
+
+    void unmap() noexcept {
+#ifdef LOGVALCPP_HAS_MMAP
+        if (this->data_ != nullptr) {
+            ::munmap(const_cast<std::byte *>(this->data_), this->size_);
+        }
+#endif
+        this->data_ = nullptr;
+        this->size_ = 0;
+    }
+
+    FileHeader header_{};
+    const std::byte *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::vector<std::uint64_t> buffer_;
+};
+
+}  // namespace logval::io
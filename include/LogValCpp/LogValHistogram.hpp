@@ -0,0 +1,177 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <LogValCpp/PackedLogVal.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Histogram of LogVals which can be updated concurrently without locks,
+ * e.g. by the walkers of a Wang-Landau simulation.
+ *
+ * Every bin is a single atomic word holding a PackedLogVal, updated with a
+ * compare-and-swap loop. Thus values lose one bit of precision of their
+ * logarithm. Bins are padded to a cache line, so walkers working
+ * on neighbouring bins do not slow each other down.
+ *
+ * Reading operations see every bin at some point in time, but bins are not
+ * read atomically together.
+ */
+template <typename T = double>
+    requires(std::same_as<T, float> || std::same_as<T, double>)
+class LogValHistogram {
+   public:
+    /**
+     * Create a histogram of `bins` bins set to `value`.
+     */
+    explicit LogValHistogram(std::size_t bins,
+                             LogVal<T> value = LogVal<T>(T(0)))
+        : bins_(bins) {
+        reset(value);
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        return bins_.size();
+    }
+
+    /**
+     * Read bin `bin`.
+     */
+    [[nodiscard]] auto get(std::size_t bin) const -> LogVal<T> {
+        return unpack(bins_[bin].packed.load(std::memory_order_relaxed));
+    }
+
+    [[nodiscard]] auto operator[](std::size_t bin) const -> LogVal<T> {
+        return get(bin);
+    }
+
+    /**
+     * Overwrite bin `bin` with `value`.
+     */
+    void set(std::size_t bin, LogVal<T> value) {
+        bins_[bin].packed.store(pack(value), std::memory_order_relaxed);
+    }
+
+    /**
+     * Add `value` to bin `bin`, can be called concurrently.
+     *
+     * @returns the new value of the bin.
+     */
+    auto add(std::size_t bin, LogVal<T> value) -> LogVal<T> {
+        return update(bin, [&value](LogVal<T> &current) { current += value; });
+    }
+
+    /**
+     * Multiply bin `bin` with `value`, can be called concurrently.
+     *
+     * This is the update `g(E) *= f` of a Wang-Landau simulation.
+     *
+     * @returns the new value of the bin.
+     */
+    auto multiply(std::size_t bin, LogVal<T> value) -> LogVal<T> {
+        return update(bin, [&value](LogVal<T> &current) { current *= value; });
+    }
+
+    /**
+     * Copy all bins.
+     */
+    [[nodiscard]] auto snapshot() const -> LogValArray<T> {
+        LogValArray<T> res;
+        for (std::size_t bin = 0; bin < size(); ++bin) {
+            res.push_back(get(bin));
+        }
+        return res;
+    }
+
+    /**
+     * Copy all bins, scaled such that their sum is `total`.
+     *
+     * @returns the scaled bins, zero if all bins are zero.
+     */
+    [[nodiscard]] auto normalized(LogVal<T> total = LogVal<T>(T(1))) const
+        -> LogValArray<T> {
+        auto res = snapshot();
+        const LogVal<T> sum = logval::sum(res);
+        if (sum.sign() != LogVal<T>::Sign::null) {
+            res *= total / sum;
+        }
+        return res;
+    }
+
+    /**
+     * Test if the histogram is flat, i.e. if no bin is below `ratio` times
+     * the mean of all bins, as used as convergence criterion of
+     * Wang-Landau simulations (typically with `ratio = 0.8`).
+     *
+     * The comparison is done on logarithms, so histograms beyond the range
+     * of `T` are handled.
+     *
+     * @returns `true` if all bins are at least `ratio` times the mean.
+     */
+    [[nodiscard]] auto is_flat(T ratio) const -> bool {
+        const auto bins = snapshot();
+        if (bins.size() == 0) {
+            return true;
+        }
+
+        const LogVal<T> threshold = logval::sum(bins) *
+                                    LogVal<T>(ratio) /
+                                    LogVal<T>(static_cast<T>(bins.size()));
+        for (std::size_t bin = 0; bin < bins.size(); ++bin) {
+            if (bins[bin] < threshold) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Set all bins to `value`.
+     */
+    void reset(LogVal<T> value = LogVal<T>(T(0))) {
+        const Bits packed = pack(value);
+        for (auto &bin : bins_) {
+            bin.packed.store(packed, std::memory_order_relaxed);
+        }
+    }
+
+   private:
+    using Bits = typename PackedLogVal<T>::bits_type;
+
+    static_assert(std::atomic<Bits>::is_always_lock_free);
+
+    struct alignas(64) Bin {
+        std::atomic<Bits> packed;
+    };
+
+    [[nodiscard]] static auto pack(LogVal<T> value) noexcept -> Bits {
+        return PackedLogVal<T>(value).bits();
+    }
+
+    [[nodiscard]] static auto unpack(Bits bits) noexcept -> LogVal<T> {
+        return PackedLogVal<T>::from_bits(bits).unpack();
+    }
+
+    template <typename Op>
+    auto update(std::size_t bin, Op op) -> LogVal<T> {
+        auto &packed = bins_[bin].packed;
+        Bits expected = packed.load(std::memory_order_relaxed);
+        LogVal<T> value = unpack(expected);
+        while (true) {
+            op(value);
+            const Bits desired = pack(value);
+            if (packed.compare_exchange_weak(expected, desired,
+                                             std::memory_order_relaxed)) {
+                return unpack(desired);
+            }
+            value = unpack(expected);
+        }
+    }
+
+    std::vector<Bin> bins_;
+};
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <LogValCpp/detail/ConstexprMath.hpp>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <concepts>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+/**
+ * Math policies selecting the base of the logarithm and the kernels used by
+ * LogVal conversions and additions.
+ *
+ * With `log` and `exp` to the base of the policy, a policy provides
+ * `log(val)`, `exp(val)`, `add(larger, smaller)` returning
+ * `larger + log(1 + exp(smaller - larger))` and `subtract(larger, smaller)`
+ * returning `larger + log(1 - exp(smaller - larger))` for
+ * `larger >= smaller`. `ln_base<T>` is the natural logarithm of the base.
+ */
+template <typename P, typename T>
+concept LogValMathPolicy = std::floating_point<T> && requires(T val) {
+    { P::log(val) } -> std::same_as<T>;
+    { P::exp(val) } -> std::same_as<T>;
+    { P::add(val, val) } -> std::same_as<T>;
+    { P::subtract(val, val) } -> std::same_as<T>;
+    { P::template ln_base<T> } -> std::convertible_to<T>;
+};
+
+/**
+ * Default policy using the standard library.
+ *
+ * The error of `add` is the error of `std::log1p` and `std::exp`, a few ulps.
+ * The absolute error of `subtract` grows like `epsilon / (1 - exp(-d))` for
+ * `d = larger - smaller` approaching zero, since `1 - exp(-d)` cancels.
+ */
+struct ExactMath {
+    template <std::floating_point T>
+    static constexpr T ln_base = T(1);
+
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto log(T val) noexcept -> T {
+        return logval::detail::log(val);
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto exp(T val) noexcept -> T {
+        return logval::detail::exp(val);
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto add(T larger, T smaller) noexcept
+        -> T {
+        return larger + logval::detail::log1p(
+                            logval::detail::exp(smaller - larger));
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto subtract(T larger, T smaller) noexcept
+        -> T {
+        return larger + logval::detail::log(
+                            T(1.0) - logval::detail::exp(smaller - larger));
+    }
+};
+
+/**
+ * Policy trading accuracy for speed.
+ *
+ * Error bound: the absolute error of the logarithm returned by `add` and
+ * `subtract` is at most `MaxUlp * std::numeric_limits<T>::epsilon()`, plus
+ * the rounding of the final addition to `larger` (half an ulp of the result).
+ *
+ * The speed up comes from:
+ * * Once `d = larger - smaller` is so large that `log(1 +- exp(-d))` drops
+ *   below the error bound, `larger` is returned directly, without any
+ *   transcendental function. This is the common case for additions of
+ *   values with very different magnitudes.
+ * * For larger bounds (from 12 ulps on for `double`), `log(1 + exp(-d))`
+ *   is interpolated from a table of Taylor polynomials on intervals of width
+ *   1/4 instead of calling `std::exp` and `std::log1p`. The degree of the
+ *   polynomials is the smallest one meeting the bound.
+ *
+ * Close operands in `subtract` use `log(-expm1(-d))`, which is, in contrast
+ * to ExactMath, accurate in the presence of cancellation.
+ *
+ * @tparam MaxUlp error bound in multiples of the machine epsilon.
+ */
+template <unsigned MaxUlp>
+    requires(MaxUlp >= 1)
+struct FastMath {
+    template <std::floating_point T>
+    static constexpr T ln_base = T(1);
+
+    /** Maximal absolute error of the returned logarithm for `T`. */
+    template <std::floating_point T>
+    static constexpr T max_error =
+        static_cast<T>(MaxUlp) * std::numeric_limits<T>::epsilon();
+
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto log(T val) noexcept -> T {
+        return ExactMath::log(val);
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto exp(T val) noexcept -> T {
+        return ExactMath::exp(val);
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto add(T larger, T smaller) noexcept
+        -> T {
+        // The table can not be used in constant expressions.
+        if (std::is_constant_evaluated()) {
+            return ExactMath::add(larger, smaller);
+        }
+        const T diff = larger - smaller;
+        if (diff > cutoff<T>()) {
+            return larger;
+        }
+        if constexpr (table_degree<T>() > 0) {
+            return larger + static_cast<T>(softplus_table<T>(diff));
+        } else {
+            return larger + std::log1p(std::exp(-diff));
+        }
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto subtract(T larger, T smaller) noexcept
+        -> T {
+        if (std::is_constant_evaluated()) {
+            return ExactMath::subtract(larger, smaller);
+        }
+        const T diff = larger - smaller;
+        if (diff > cutoff<T>()) {
+            return larger;
+        }
+        return larger + std::log(-std::expm1(-diff));
+    }
+
+   private:
+    /** Inverse width of the intervals of the interpolation table. */
+    static constexpr double inv_width = 4.0;
+
+    /**
+     * Difference beyond which `|log(1 +- exp(-d))| < 2 * exp(-d) <=
+     * max_error`.
+     *
+     * Uses `floor(log2(MaxUlp))`, which gives a slightly larger (safe)
+     * cutoff but can be computed at compile time.
+     */
+    template <std::floating_point T>
+    [[nodiscard]] static consteval auto cutoff() -> T {
+        int log2_ulp = 0;
+        for (unsigned ulp = MaxUlp; ulp > 1; ulp /= 2) {
+            ++log2_ulp;
+        }
+        return static_cast<T>(std::numeric_limits<T>::digits - log2_ulp) *
+               std::numbers::ln2_v<T>;
+    }
+
+    /**
+     * Degree of the Taylor polynomials in the interpolation table, or 0 if
+     * the bound can not be met by a table and the standard library is used.
+     *
+     * The closest singularities of `log(1 + exp(-d))` are logarithmic ones at
+     * `d = +-i * pi`, so the `k`-th coefficient is bounded by
+     * `2 / (k * pi^k)` and the truncation error of degree `p` with
+     * `r = width / 2 / pi` is below `2 * r^(p + 1) / ((p + 1) * (1 - r))`.
+     * Two epsilons are reserved for the rounding of the evaluation.
+     */
+    template <std::floating_point T>
+    [[nodiscard]] static consteval auto table_degree() -> int {
+        if constexpr (std::is_same_v<T, long double>) {
+            return 0;
+        } else {
+            constexpr int min_degree = 4;
+            constexpr int max_degree = 9;
+            const double ratio = 1.0 / (2.0 * inv_width * std::numbers::pi);
+            const double budget =
+                (static_cast<double>(MaxUlp) - 2.0) *
+                static_cast<double>(std::numeric_limits<T>::epsilon());
+
+            double power = ratio;
+            for (int degree = 1; degree <= max_degree; ++degree) {
+                power *= ratio;
+                const double error =
+                    2.0 * power / ((degree + 1) * (1.0 - ratio));
+                if (degree >= min_degree && error <= budget) {
+                    return degree;
+                }
+            }
+            return 0;
+        }
+    }
+
+    template <std::floating_point T>
+    struct SoftplusTable {
+        static constexpr int degree = table_degree<T>();
+        static constexpr auto intervals =
+            static_cast<std::size_t>(cutoff<T>() * inv_width) + 1;
+
+        /**
+         * Taylor coefficients of `f(d) = log(1 + exp(-d))` around the
+         * centers of the intervals.
+         *
+         * With `g(d) = 1 / (1 + exp(d))` the derivatives are `f' = -g` and
+         * `g' = -g (1 - g)`, so `g^(n) = P_n(g)` with polynomials following
+         * `P_{n+1}(g) = -P_n'(g) * (g - g^2)`.
+         */
+        constexpr SoftplusTable() {
+            std::array<std::array<double, degree + 2>, degree> poly{};
+            poly[0][1] = 1.0;
+            for (int n = 0; n + 1 < degree; ++n) {
+                for (int k = 1; k <= n + 1; ++k) {
+                    const double deriv = k * poly[n][k];
+                    poly[n + 1][k] -= deriv;
+                    poly[n + 1][k + 1] += deriv;
+                }
+            }
+
+            for (std::size_t i = 0; i < intervals; ++i) {
+                const double center =
+                    (static_cast<double>(i) + 0.5) / inv_width;
+                const double g = 1.0 / (1.0 + logval::detail::exp(center));
+
+                coeffs[i][0] =
+                    logval::detail::log1p(logval::detail::exp(-center));
+                double factorial = 1.0;
+                for (int k = 1; k <= degree; ++k) {
+                    factorial *= k;
+                    double deriv = 0.0;
+                    for (int j = degree + 1; j >= 0; --j) {
+                        deriv = deriv * g + poly[k - 1][j];
+                    }
+                    coeffs[i][k] = -deriv / factorial;
+                }
+            }
+        }
+
+        std::array<std::array<double, degree + 1>, intervals> coeffs{};
+    };
+
+    /** Computed at compile time, so lookups need no initialization guard. */
+    template <std::floating_point T>
+    static constexpr SoftplusTable<T> softplus_coeffs{};
+
+    /**
+     * `log(1 + exp(-diff))` for `0 <= diff <= cutoff` from the table.
+     */
+    template <std::floating_point T>
+    [[nodiscard]] static auto softplus_table(T diff) noexcept -> double {
+        const double scaled = static_cast<double>(diff) * inv_width;
+        const auto index = static_cast<std::size_t>(scaled);
+        const double x =
+            (scaled - static_cast<double>(index) - 0.5) / inv_width;
+        const auto &coeffs = softplus_coeffs<T>.coeffs[index];
+
+        double res = coeffs[SoftplusTable<T>::degree];
+        for (int k = SoftplusTable<T>::degree - 1; k >= 0; --k) {
+            res = res * x + coeffs[k];
+        }
+        return res;
+    }
+};
+
+/**
+ * Policy using logarithms to base 2.
+ *
+ * `exp2` and `log2` are cheaper than `exp` and `log` in most math libraries
+ * (the power of two is assembled directly in the exponent bits), so
+ * conversions from and to `T` get faster. Additions and subtractions have
+ * the same error behaviour as ExactMath (in units of `log2`).
+ *
+ * Use the explicit conversion constructor of LogVal to change the base.
+ */
+struct Base2 {
+    template <std::floating_point T>
+    static constexpr T ln_base = std::numbers::ln2_v<T>;
+
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto log(T val) noexcept -> T {
+        return logval::detail::log2(val);
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto exp(T val) noexcept -> T {
+        return logval::detail::exp2(val);
+    }
+
+    /** `log2(1 + y) = log1p(y) / ln(2)` keeps the accuracy for small y. */
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto add(T larger, T smaller) noexcept
+        -> T {
+        return larger + logval::detail::log1p(
+                            logval::detail::exp2(smaller - larger)) *
+                            std::numbers::log2e_v<T>;
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]] static constexpr auto subtract(T larger, T smaller) noexcept
+        -> T {
+        return larger + logval::detail::log2(
+                            T(1.0) - logval::detail::exp2(smaller - larger));
+    }
+};
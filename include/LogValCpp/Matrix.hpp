@@ -0,0 +1,413 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/Parallel.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace logval {
+
+/** Memory layout of a matrix. */
+enum class Layout {
+    row_major,
+    column_major,
+};
+
+/**
+ * Non-owning view of a matrix of LogVals.
+ *
+ * Element `(i, j)` is `data[i * leading_dim + j]` for row-major and
+ * `data[j * leading_dim + i]` for column-major matrices.
+ *
+ * @tparam V element type, `LogVal<T>` or `const LogVal<T>`.
+ */
+template <typename V>
+class MatrixView {
+   public:
+    using value_type = std::remove_const_t<V>;
+
+    MatrixView(V *data, std::size_t rows, std::size_t cols,
+               Layout layout = Layout::row_major)
+        : MatrixView(data, rows, cols, layout,
+                     layout == Layout::row_major ? cols : rows) {}
+
+    MatrixView(V *data, std::size_t rows, std::size_t cols, Layout layout,
+               std::size_t leading_dim)
+        : data_(data),
+          rows_(rows),
+          cols_(cols),
+          layout_(layout),
+          leading_dim_(leading_dim) {}
+
+    /** Views of mutable matrices convert to views of constant matrices. */
+    operator MatrixView<const V>() const
+        requires(!std::is_const_v<V>)
+    {
+        return {data_, rows_, cols_, layout_, leading_dim_};
+    }
+
+    [[nodiscard]] auto rows() const noexcept -> std::size_t { return rows_; }
+    [[nodiscard]] auto cols() const noexcept -> std::size_t { return cols_; }
+    [[nodiscard]] auto layout() const noexcept -> Layout { return layout_; }
+
+    [[nodiscard]] auto operator()(std::size_t row, std::size_t col) const
+        -> V & {
+        return layout_ == Layout::row_major ? data_[row * leading_dim_ + col]
+                                            : data_[col * leading_dim_ + row];
+    }
+
+    /**
+     * View of `count` rows starting at row `first`.
+     */
+    [[nodiscard]] auto row_block(std::size_t first, std::size_t count) const
+        -> MatrixView {
+        V *start = layout_ == Layout::row_major ? data_ + first * leading_dim_
+                                                : data_ + first;
+        return {start, count, cols_, layout_, leading_dim_};
+    }
+
+   private:
+    V *data_;
+    std::size_t rows_;
+    std::size_t cols_;
+    Layout layout_;
+    std::size_t leading_dim_;
+};
+
+namespace detail {
+
+/** Rows of A packed at once, small enough that the packed A stays in L2. */
+inline constexpr std::size_t gemm_block_rows = 64;
+
+/** Depth of a packed block, a packed row of A stays in L1. */
+inline constexpr std::size_t gemm_block_depth = 256;
+
+/** Columns of B packed at once, the packed block of B stays in L2. */
+inline constexpr std::size_t gemm_block_cols = 256;
+
+/** Rows of C updated together, each loaded row of B is reused that often. */
+inline constexpr std::size_t gemm_register_rows = 4;
+
+/**
+ * `sign * exp(log_abs - max)` of a LogVal, zero for `max == -inf`.
+ */
+template <typename V, typename T>
+[[nodiscard]] auto scaled_value(const V &val, T max) -> T {
+    if (val.sign() == V::Sign::null ||
+        max == -std::numeric_limits<T>::infinity()) {
+        return T(0);
+    }
+    const T scaled = std::exp(natural_log(val) - max);
+    return val.sign() == V::Sign::negative ? -scaled : scaled;
+}
+
+template <typename V>
+[[nodiscard]] auto log_or_neg_inf(const V &val) {
+    using T = decltype(val.log_abs());
+    return val.sign() == V::Sign::null ? -std::numeric_limits<T>::infinity()
+                                       : natural_log(val);
+}
+
+/**
+ * Smallest magnitude of a sum of `count` scaled products which is reliable.
+ *
+ * Above it, the largest product is at least `min<T> / epsilon<T>`, so the
+ * products which are subnormal or underflow to zero are below the rounding
+ * error of the sum. Smaller sums are recomputed with `scaled_products`.
+ */
+template <typename T>
+[[nodiscard]] auto reliable_scaled_sum(std::size_t count) -> T {
+    return static_cast<T>(count) * std::numeric_limits<T>::min() /
+           std::numeric_limits<T>::epsilon();
+}
+
+/**
+ * Sum of the `count` products `lhs(k) * rhs(k)` of LogVals, reduced with the
+ * blocked kernel of `logval::sum`, so no product underflows.
+ */
+template <typename T, typename Lhs, typename Rhs>
+[[nodiscard]] auto scaled_products(std::size_t count, Lhs lhs, Rhs rhs)
+    -> ScaledSum<T> {
+    std::array<T, sum_block_size> logs;
+    std::array<bool, sum_block_size> negative;
+
+    ScaledSum<T> res;
+    for (std::size_t offset = 0; offset < count; offset += sum_block_size) {
+        const std::size_t block = std::min(sum_block_size, count - offset);
+        for (std::size_t k = 0; k < block; ++k) {
+            const auto lhs_val = lhs(offset + k);
+            const auto rhs_val = rhs(offset + k);
+            using V = std::remove_const_t<decltype(lhs_val)>;
+            const bool is_null = lhs_val.sign() == V::Sign::null ||
+                                 rhs_val.sign() == V::Sign::null;
+            logs[k] = is_null ? -std::numeric_limits<T>::infinity()
+                              : natural_log(lhs_val) + natural_log(rhs_val);
+            negative[k] = !is_null && lhs_val.sign() != rhs_val.sign();
+        }
+        res.merge(scaled_block_sum(
+            logs.data(), block,
+            [&negative](std::size_t k) { return negative[k]; }));
+    }
+    return res;
+}
+
+/**
+ * Add `exp(scale) * val` to the accumulator `exp(log_ref) * val_ref`.
+ */
+template <typename T>
+void merge_scaled(T &log_ref, T &val_ref, T scale, T val) {
+    if (scale > log_ref) {
+        val_ref = val_ref * std::exp(log_ref - scale) + val;
+        log_ref = scale;
+    } else {
+        val_ref += val * std::exp(scale - log_ref);
+    }
+}
+
+/**
+ * `c[i][j] += sum_k a[i][k] * b[k][j]` for packed, row-major blocks.
+ *
+ * `gemm_register_rows` rows of C are updated per loaded row of B, the inner
+ * loop over the columns is a plain FMA which the compiler vectorizes.
+ */
+template <typename T>
+void gemm_kernel(const T *a, const T *b, T *c, std::size_t rows,
+                 std::size_t depth, std::size_t cols) {
+    constexpr std::size_t mr = gemm_register_rows;
+
+    std::size_t i = 0;
+    for (; i + mr <= rows; i += mr) {
+        T *c0 = c + i * cols;
+        T *c1 = c0 + cols;
+        T *c2 = c1 + cols;
+        T *c3 = c2 + cols;
+        const T *a0 = a + i * depth;
+        for (std::size_t k = 0; k < depth; ++k) {
+            const T a0k = a0[k];
+            const T a1k = a0[depth + k];
+            const T a2k = a0[2 * depth + k];
+            const T a3k = a0[3 * depth + k];
+            const T *bk = b + k * cols;
+            for (std::size_t j = 0; j < cols; ++j) {
+                c0[j] += a0k * bk[j];
+                c1[j] += a1k * bk[j];
+                c2[j] += a2k * bk[j];
+                c3[j] += a3k * bk[j];
+            }
+        }
+    }
+    for (; i < rows; ++i) {
+        T *ci = c + i * cols;
+        for (std::size_t k = 0; k < depth; ++k) {
+            const T aik = a[i * depth + k];
+            const T *bk = b + k * cols;
+            for (std::size_t j = 0; j < cols; ++j) {
+                ci[j] += aik * bk[j];
+            }
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Matrix product `C = A B` of LogVals.
+ *
+ * The matrices are processed in blocks. A block of `A` is packed with every
+ * row scaled by its maximum, a block of `B` with every column scaled by its
+ * maximum, so that the product of the packed blocks is a plain product of
+ * `T` values in [-1, 1] which can not overflow. The partial products of
+ * all blocks along the inner dimension are merged into a logarithmic scale
+ * and a mantissa per element of `C`. Thus only `O(n^2)` exponentials per
+ * block are needed instead of `O(n^3)` `operator+=` calls.
+ *
+ * Products far below the product of the row and column maximum underflow in
+ * the packed blocks. Elements of a block whose scaled sum is so small that
+ * this can matter are recomputed with the kernel of `logval::sum` (as in
+ * `gemv`), so the result is accurate for any dynamic range. This only costs
+ * time for elements which are zero or tiny compared to these maxima.
+ *
+ * @param a matrix of size m x k.
+ * @param b matrix of size k x n.
+ * @param c matrix of size m x n, overwritten with the product.
+ */
+template <typename VA, typename VB, typename VC>
+    requires std::same_as<std::remove_const_t<VA>, VC> &&
+             std::same_as<std::remove_const_t<VB>, VC>
+void gemm(MatrixView<VA> a, MatrixView<VB> b, MatrixView<VC> c) {
+    using T = typename VC::value_type;
+    using Sign = typename VC::Sign;
+
+    const std::size_t m = a.rows();
+    const std::size_t depth = a.cols();
+    const std::size_t n = b.cols();
+
+    // C(i, j) = exp(acc_log[i * n + j]) * acc_val[i * n + j]
+    std::vector<T> acc_log(m * n, -std::numeric_limits<T>::infinity());
+    std::vector<T> acc_val(m * n, T(0));
+
+    std::vector<T> packed_a(detail::gemm_block_rows *
+                            detail::gemm_block_depth);
+    std::vector<T> packed_b(detail::gemm_block_depth *
+                            detail::gemm_block_cols);
+    std::vector<T> tile(detail::gemm_block_rows * detail::gemm_block_cols);
+    std::array<T, detail::gemm_block_rows> row_max{};
+    std::array<T, detail::gemm_block_cols> col_max{};
+
+    for (std::size_t jc = 0; jc < n; jc += detail::gemm_block_cols) {
+        const std::size_t nc = std::min(detail::gemm_block_cols, n - jc);
+        for (std::size_t pc = 0; pc < depth; pc += detail::gemm_block_depth) {
+            const std::size_t kc =
+                std::min(detail::gemm_block_depth, depth - pc);
+
+            col_max.fill(-std::numeric_limits<T>::infinity());
+            for (std::size_t k = 0; k < kc; ++k) {
+                for (std::size_t j = 0; j < nc; ++j) {
+                    col_max[j] = std::max(
+                        col_max[j], detail::log_or_neg_inf(b(pc + k, jc + j)));
+                }
+            }
+            for (std::size_t k = 0; k < kc; ++k) {
+                for (std::size_t j = 0; j < nc; ++j) {
+                    packed_b[k * nc + j] =
+                        detail::scaled_value(b(pc + k, jc + j), col_max[j]);
+                }
+            }
+
+            for (std::size_t ic = 0; ic < m; ic += detail::gemm_block_rows) {
+                const std::size_t mc =
+                    std::min(detail::gemm_block_rows, m - ic);
+
+                for (std::size_t i = 0; i < mc; ++i) {
+                    row_max[i] = -std::numeric_limits<T>::infinity();
+                    for (std::size_t k = 0; k < kc; ++k) {
+                        row_max[i] =
+                            std::max(row_max[i],
+                                     detail::log_or_neg_inf(a(ic + i, pc + k)));
+                    }
+                    for (std::size_t k = 0; k < kc; ++k) {
+                        packed_a[i * kc + k] =
+                            detail::scaled_value(a(ic + i, pc + k), row_max[i]);
+                    }
+                }
+
+                std::fill(tile.begin(), tile.begin() + mc * nc, T(0));
+                detail::gemm_kernel(packed_a.data(), packed_b.data(),
+                                    tile.data(), mc, kc, nc);
+
+                // Merge the block into the scaled accumulators.
+                const T reliable = detail::reliable_scaled_sum<T>(kc);
+                for (std::size_t i = 0; i < mc; ++i) {
+                    if (row_max[i] == -std::numeric_limits<T>::infinity()) {
+                        continue;
+                    }
+                    for (std::size_t j = 0; j < nc; ++j) {
+                        if (col_max[j] == -std::numeric_limits<T>::infinity()) {
+                            continue;
+                        }
+                        T &log_ref = acc_log[(ic + i) * n + jc + j];
+                        T &val_ref = acc_val[(ic + i) * n + jc + j];
+                        const T val = tile[i * nc + j];
+                        if (std::abs(val) >= reliable) {
+                            detail::merge_scaled(log_ref, val_ref,
+                                                 row_max[i] + col_max[j], val);
+                            continue;
+                        }
+                        // Products may have underflowed, sum them exactly.
+                        const auto exact = detail::scaled_products<T>(
+                            kc,
+                            [&](std::size_t k) { return a(ic + i, pc + k); },
+                            [&](std::size_t k) { return b(pc + k, jc + j); });
+                        if (exact.max != -std::numeric_limits<T>::infinity()) {
+                            detail::merge_scaled(
+                                log_ref, val_ref, exact.max,
+                                exact.positive - exact.negative);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const T val = acc_val[i * n + j];
+            if (val == T(0)) {
+                c(i, j) = VC::from_log(T(0), Sign::null);
+            } else {
+                c(i, j) = detail::from_natural_log<VC>(
+                    acc_log[i * n + j] + std::log(std::abs(val)),
+                    val > T(0) ? Sign::positive : Sign::negative);
+            }
+        }
+    }
+}
+
+/**
+ * Matrix vector product `y = A x` of LogVals.
+ *
+ * Every element of `y` is reduced with the blocked kernel of `logval::sum`.
+ *
+ * @param a matrix of size m x n.
+ * @param x pointer to `n` LogVals.
+ * @param y pointer to `m` LogVals, overwritten with the product.
+ */
+template <typename VA, typename V>
+    requires std::same_as<std::remove_const_t<VA>, V>
+void gemv(MatrixView<VA> a, const V *x, V *y) {
+    using T = typename V::value_type;
+
+    for (std::size_t i = 0; i < a.rows(); ++i) {
+        y[i] = detail::scaled_products<T>(
+                   a.cols(), [&](std::size_t k) { return a(i, k); },
+                   [x](std::size_t k) { return x[k]; })
+                   .template result<V>();
+    }
+}
+
+namespace par {
+
+/**
+ * Matrix product `C = A B` of LogVals using multiple threads.
+ *
+ * The rows of `C` are split between the threads, every element is computed
+ * exactly like in `logval::gemm`, so the result does not depend on the
+ * number of threads.
+ */
+template <typename VA, typename VB, typename VC>
+    requires std::same_as<std::remove_const_t<VA>, VC> &&
+             std::same_as<std::remove_const_t<VB>, VC>
+void gemm(MatrixView<VA> a, MatrixView<VB> b, MatrixView<VC> c,
+          const Options &options = {}) {
+    const std::size_t rows = a.rows();
+    const std::size_t threads =
+        std::min<std::size_t>(detail::thread_count(options),
+                              std::max<std::size_t>(rows, 1));
+    // Keep the row blocks aligned to the blocks of the serial kernel.
+    const std::size_t block = logval::detail::gemm_block_rows;
+    const std::size_t blocks = (rows + block - 1) / block;
+    const std::size_t blocks_per_thread = (blocks + threads - 1) / threads;
+
+    std::vector<std::jthread> pool;
+    for (std::size_t first = 0; first < rows;
+         first += blocks_per_thread * block) {
+        const std::size_t count =
+            std::min(blocks_per_thread * block, rows - first);
+        pool.emplace_back([a, b, c, first, count]() {
+            logval::gemm(a.row_block(first, count), b,
+                         c.row_block(first, count));
+        });
+    }
+}
+
+}  // namespace par
+
+}  // namespace logval
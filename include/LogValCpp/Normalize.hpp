@@ -0,0 +1,146 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <LogValCpp/detail/VectorMath.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+
+/**
+ * Normalization of LogVal weights, e.g. for importance sampling.
+ *
+ * Instead of a sum with `operator+=`, a division per element and a `to()`
+ * per element, which are three passes with about three transcendental
+ * functions per element, the functions here need at most two passes: the
+ * blocked, max-scaled sum of `logval::sum` (one `exp` per element and a
+ * single `log`) and a write-out which subtracts the log of the sum and, for
+ * `to_probabilities`, takes one `exp` per element. For non-negative weights
+ * that `exp` is the vectorizable kernel of `logval::sum`.
+ */
+namespace logval {
+
+/**
+ * Logarithm of the sum of all `values` to the base of `Policy`, i.e. the log
+ * partition function of the weights. One pass.
+ *
+ * @returns `log(|sum|)`, `-inf` for a zero sum or an empty span.
+ */
+template <typename T, typename Policy, std::size_t Extent>
+[[nodiscard]] auto log_partition(
+    std::span<const LogVal<T, Policy>, Extent> values) -> T {
+    return sum(values).log_abs();
+}
+
+template <typename T, typename Policy, std::size_t Extent>
+[[nodiscard]] auto log_partition(std::span<LogVal<T, Policy>, Extent> values)
+    -> T {
+    return sum(values).log_abs();
+}
+
+/**
+ * Divide all `values` by their sum in place, so that they sum up to one.
+ *
+ * The second pass only subtracts the logarithm of the sum from every
+ * logarithm, it needs no transcendental functions. A zero sum leaves the
+ * values unchanged.
+ *
+ * @returns the sum of the values before the normalization.
+ */
+template <typename T, typename Policy, std::size_t Extent>
+auto normalize(std::span<LogVal<T, Policy>, Extent> values)
+    -> LogVal<T, Policy> {
+    using V = LogVal<T, Policy>;
+
+    const V total = sum(values);
+    if (total.sign() == V::Sign::null) {
+        return total;
+    }
+    for (auto &val : values) {
+        val /= total;
+    }
+    return total;
+}
+
+/**
+ * Write the probabilities `values[i] / sum(values)` as plain numbers to
+ * `out`, which needs at least `values.size()` elements.
+ *
+ * Zeros give zero, a zero sum gives `nan` for all elements like a division
+ * by zero.
+ *
+ * @returns the sum of the values.
+ */
+template <typename T, typename Policy, std::size_t Extent,
+          std::size_t OutExtent>
+auto to_probabilities(std::span<const LogVal<T, Policy>, Extent> values,
+                      std::span<T, OutExtent> out) -> LogVal<T, Policy> {
+    using V = LogVal<T, Policy>;
+
+    const auto scaled = detail::scaled_sum(values.begin(), values.end());
+    const V total = scaled.template result<V>();
+    if (total.sign() == V::Sign::null) {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            out[i] = std::numeric_limits<T>::quiet_NaN();
+        }
+        return total;
+    }
+
+    const T log_total = detail::natural_log(total);
+    const T sign_total = total.sign() == V::Sign::negative ? T(-1) : T(1);
+    if (scaled.negative == T(0)) {
+        // No term exceeds the sum, so the kernel without calls applies. As in
+        // `scaled_block_sum`, the logarithms are gathered blockwise and padded
+        // to a multiple of `sum_lanes`, so that the loop calling the kernel
+        // vectorizes. The sign also covers negative terms which underflowed
+        // in the sum.
+        std::array<T, detail::sum_block_size> block;
+        std::array<T, detail::sum_block_size> signs;
+        for (std::size_t offset = 0; offset < values.size();
+             offset += detail::sum_block_size) {
+            const std::size_t count =
+                std::min(detail::sum_block_size, values.size() - offset);
+            const std::size_t padded = (count + detail::sum_lanes - 1) /
+                                       detail::sum_lanes * detail::sum_lanes;
+            for (std::size_t k = 0; k < count; ++k) {
+                const V &val = values[offset + k];
+                block[k] = std::min(detail::natural_log(val) - log_total, T(0));
+                signs[k] = static_cast<T>(static_cast<int>(val.sign()));
+            }
+            for (std::size_t k = count; k < padded; ++k) {
+                block[k] = T(0);
+                signs[k] = T(0);
+            }
+            for (std::size_t k = 0; k < padded; ++k) {
+                block[k] = signs[k] * detail::exp_nonpositive(block[k]);
+            }
+            std::copy_n(block.begin(), count, out.begin() + offset);
+        }
+    } else {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            const V &val = values[i];
+            if (val.sign() == V::Sign::null) {
+                out[i] = T(0);
+                continue;
+            }
+            const T scaled_val =
+                std::exp(detail::natural_log(val) - log_total);
+            out[i] = val.sign() == V::Sign::negative ? -sign_total * scaled_val
+                                                     : sign_total * scaled_val;
+        }
+    }
+    return total;
+}
+
+template <typename T, typename Policy, std::size_t Extent,
+          std::size_t OutExtent>
+auto to_probabilities(std::span<LogVal<T, Policy>, Extent> values,
+                      std::span<T, OutExtent> out) -> LogVal<T, Policy> {
+    return to_probabilities(std::span<const LogVal<T, Policy>, Extent>(values),
+                            out);
+}
+
+}  // namespace logval
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+/**
+ * LogVal packed into a single word of the size of `T`.
+ *
+ * `sizeof(LogVal<double>)` is 16 because of the padding after its sign. Here
+ * the sign is stored in the last mantissa bit of the logarithm instead, and
+ * zero is the bit pattern of `-inf`. Thus twice as many values fit into a
+ * cache line, `std::atomic<PackedLogVal<T>>` is lock-free and arrays can be
+ * mapped from disk directly.
+ *
+ * The price is one bit of the logarithm: the stored logarithm is rounded to
+ * an even mantissa, i.e. it is off by at most one ulp. An odd mantissa is
+ * halfway between two even ones, it goes to the one whose next bit is zero
+ * (round half to even on the coarser grid), so repeated packing, e.g. in
+ * the update loops of atomics, is not biased in one direction. Arithmetic is
+ * done by LogVal with the same `Policy`, so the API and all error bounds are
+ * those of LogVal plus this rounding.
+ *
+ * A negative value with the logarithm `+inf` has no bit pattern, setting the
+ * last bit of `+inf` would give a NaN. It is packed as the negative value
+ * with the largest finite logarithm. The undefined result of a division by
+ * zero, which LogVal converts to a non-finite number, is packed as NaN.
+ */
+template <typename T = double, typename Policy = ExactMath>
+    requires(std::same_as<T, float> || std::same_as<T, double>) &&
+            LogValMathPolicy<Policy, T>
+class PackedLogVal {
+   public:
+    using unpacked_type = LogVal<T, Policy>;
+    using Sign = typename unpacked_type::Sign;
+    using value_type = T;
+    using policy_type = Policy;
+    using bits_type =
+        std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t,
+                           std::uint64_t>;
+
+    constexpr explicit PackedLogVal(T val) : bits_(pack(unpacked_type(val))) {}
+
+    constexpr explicit PackedLogVal(const unpacked_type &val)
+        : bits_(pack(val)) {}
+
+    /**
+     * Convert a PackedLogVal using a different math policy.
+     */
+    template <typename OtherPolicy>
+        requires(!std::same_as<OtherPolicy, Policy>)
+    constexpr explicit PackedLogVal(const PackedLogVal<T, OtherPolicy> &other)
+        : bits_(pack(unpacked_type(other.unpack()))) {}
+
+    /**
+     * Convert into a LogVal with the same policy.
+     */
+    [[nodiscard]] constexpr auto unpack() const noexcept -> unpacked_type {
+        const T log_val = std::bit_cast<T>(this->bits_ & ~sign_bit);
+        if (log_val == -std::numeric_limits<T>::infinity()) {
+            return unpacked_type::from_log(log_val, Sign::null);
+        }
+        return unpacked_type::from_log(log_val, (this->bits_ & sign_bit) != 0
+                                                    ? Sign::negative
+                                                    : Sign::positive);
+    }
+
+    constexpr explicit operator unpacked_type() const noexcept {
+        return unpack();
+    }
+
+    /**
+     * Return the raw bits, e.g. for atomics or binary files.
+     */
+    [[nodiscard]] constexpr auto bits() const noexcept -> bits_type {
+        return this->bits_;
+    }
+
+    /**
+     * Create a PackedLogVal from bits returned by `bits()`.
+     */
+    [[nodiscard]] static constexpr auto from_bits(bits_type bits) noexcept
+        -> PackedLogVal {
+        return PackedLogVal(bits, BitsTag{});
+    }
+
+    /**
+     * Converts this PackedLogVal into `T` (default = `double`).
+     *
+     * @returns this PackedLogVal as `T`.
+     */
+    template <typename ToType = T>
+    [[nodiscard]] constexpr auto to() const noexcept -> ToType {
+        return unpack().template to<ToType>();
+    }
+
+    [[nodiscard]] constexpr auto as_is() const noexcept -> T {
+        return unpack().as_is();
+    }
+
+    /**
+     * Return the logarithm of the absolute value, to the base of `Policy`.
+     *
+     * @returns `log(|x|)`, which is `-inf` for zero.
+     */
+    [[nodiscard]] constexpr auto log_abs() const noexcept -> T {
+        return unpack().log_abs();
+    }
+
+    [[nodiscard]] constexpr auto sign() const noexcept -> Sign {
+        return unpack().sign();
+    }
+
+    constexpr auto operator*=(const PackedLogVal rhs) noexcept
+        -> PackedLogVal & {
+        return apply(rhs, [](unpacked_type &lhs, const unpacked_type &val) {
+            lhs *= val;
+        });
+    }
+
+    constexpr auto operator/=(const PackedLogVal rhs) noexcept
+        -> PackedLogVal & {
+        return apply(rhs, [](unpacked_type &lhs, const unpacked_type &val) {
+            lhs /= val;
+        });
+    }
+
+    constexpr auto operator+=(const PackedLogVal rhs) noexcept
+        -> PackedLogVal & {
+        return apply(rhs, [](unpacked_type &lhs, const unpacked_type &val) {
+            lhs += val;
+        });
+    }
+
+    constexpr auto operator-=(const PackedLogVal rhs) noexcept
+        -> PackedLogVal & {
+        return apply(rhs, [](unpacked_type &lhs, const unpacked_type &val) {
+            lhs -= val;
+        });
+    }
+
+    [[nodiscard]] constexpr auto operator<=>(const PackedLogVal rhs)
+        const noexcept -> std::partial_ordering {
+        return unpack() <=> rhs.unpack();
+    }
+
+    [[nodiscard]] constexpr auto operator==(const PackedLogVal rhs)
+        const noexcept -> bool {
+        return unpack() == rhs.unpack();
+    }
+
+    /** See `LogVal::order_key`. */
+    [[nodiscard]] constexpr auto order_key() const noexcept -> std::uint64_t {
+        return unpack().order_key();
+    }
+
+    constexpr auto negate() noexcept -> PackedLogVal & {
+        if (sign() != Sign::null) {
+            this->bits_ ^= sign_bit;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] constexpr auto operator-() const noexcept -> PackedLogVal {
+        return PackedLogVal(*this).negate();
+    }
+
+    [[nodiscard]] constexpr auto operator+() const noexcept -> PackedLogVal {
+        return *this;
+    }
+
+    /**
+     * Create PackedLogVal from value which is already a logarithm.
+     *
+     * @returns a PackedLogVal equivalent to `exp(log_val)`.
+     */
+    [[nodiscard]] static constexpr auto from_log(T log_val) noexcept
+        -> PackedLogVal {
+        return PackedLogVal(unpacked_type::from_log(log_val));
+    }
+
+    /**
+     * Create PackedLogVal from the logarithm of its absolute value and its
+     * sign, `Sign::null` creates zero independently of `log_val`.
+     *
+     * @returns a PackedLogVal equivalent to `sign * exp(log_val)`.
+     */
+    [[nodiscard]] static constexpr auto from_log(T log_val, Sign sign) noexcept
+        -> PackedLogVal {
+        return PackedLogVal(unpacked_type::from_log(log_val, sign));
+    }
+
+   private:
+    struct BitsTag {};
+
+    constexpr PackedLogVal(bits_type bits, BitsTag /*tag*/) : bits_(bits) {}
+
+    static constexpr bits_type sign_bit = 1;
+
+    /** Sign bit of the stored logarithm itself. */
+    static constexpr bits_type log_sign_bit = bits_type(1)
+                                              << (sizeof(T) * 8 - 1);
+
+    static constexpr bits_type infinity_bits =
+        std::bit_cast<bits_type>(std::numeric_limits<T>::infinity());
+
+    /**
+     * Store the logarithm rounded to an even mantissa with the sign in its
+     * last bit, zero is the bit pattern of `-inf`.
+     */
+    [[nodiscard]] static constexpr auto pack(const unpacked_type &val) noexcept
+        -> bits_type {
+        if (val.log_abs() == -std::numeric_limits<T>::infinity()) {
+            return std::bit_cast<bits_type>(
+                -std::numeric_limits<T>::infinity());
+        }
+        if (val.sign() == Sign::null) {
+            return std::bit_cast<bits_type>(
+                std::numeric_limits<T>::quiet_NaN());
+        }
+        const bits_type log_bits = std::bit_cast<bits_type>(val.log_abs());
+        // The magnitude of a float grows with its bits, so rounding the bits
+        // rounds the magnitude.
+        bits_type magnitude = log_bits & ~log_sign_bit;
+        if (magnitude < infinity_bits && (magnitude & sign_bit) != 0) {
+            const bool round_up =
+                (magnitude & 2U) != 0 && magnitude + 1 != infinity_bits;
+            magnitude = round_up ? magnitude + 1 : magnitude - 1;
+        }
+        const bool negative = val.sign() == Sign::negative;
+        if (negative && magnitude == infinity_bits &&
+            (log_bits & log_sign_bit) == 0) {
+            magnitude = infinity_bits - 2;
+        }
+        const bits_type bits =
+            ((log_bits & log_sign_bit) | magnitude) & ~sign_bit;
+        return negative ? bits | sign_bit : bits;
+    }
+
+    template <typename Op>
+    constexpr auto apply(const PackedLogVal rhs, Op op) noexcept
+        -> PackedLogVal & {
+        unpacked_type res = unpack();
+        op(res, rhs.unpack());
+        this->bits_ = pack(res);
+        return *this;
+    }
+
+    bits_type bits_;
+};
+
+template <typename T, typename Policy>
+[[nodiscard]] constexpr auto operator*(
+    PackedLogVal<T, Policy> lhs, const PackedLogVal<T, Policy> &rhs) noexcept
+    -> PackedLogVal<T, Policy> {
+    return lhs *= rhs;
+}
+
+template <typename T, typename Policy>
+[[nodiscard]] constexpr auto operator/(
+    PackedLogVal<T, Policy> lhs, const PackedLogVal<T, Policy> &rhs) noexcept
+    -> PackedLogVal<T, Policy> {
+    return lhs /= rhs;
+}
+
+template <typename T, typename Policy>
+[[nodiscard]] constexpr auto operator+(
+    PackedLogVal<T, Policy> lhs, const PackedLogVal<T, Policy> &rhs) noexcept
+    -> PackedLogVal<T, Policy> {
+    return lhs += rhs;
+}
+
+template <typename T, typename Policy>
+[[nodiscard]] constexpr auto operator-(
+    PackedLogVal<T, Policy> lhs, const PackedLogVal<T, Policy> &rhs) noexcept
+    -> PackedLogVal<T, Policy> {
+    return lhs -= rhs;
+}
+
+// only for debugging for now
+template <typename T, typename Policy>
+auto operator<<(std::ostream &os, const PackedLogVal<T, Policy> &rhs)
+    -> std::ostream & {
+    os << "PackedLogVal(" << rhs.as_is() << ")";
+    return os;
+}
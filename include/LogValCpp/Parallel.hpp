@@ -0,0 +1,243 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+/**
+ * Multi-threaded reductions over ranges of LogVals.
+ *
+ * A range is split into chunks, every chunk is reduced by a worker thread
+ * with the serial kernels (e.g. the blocked kernel of `logval::sum`) and the
+ * partial results are combined in a fixed pairwise tree over the chunks.
+ *
+ * By default the range is split into one chunk per thread, which gives
+ * results that are reproducible for a fixed number of threads. With
+ * `Options::deterministic` the chunk size is fixed instead, so the result is
+ * identical bit for bit for any number of threads.
+ */
+namespace logval::par {
+
+/** Options of the parallel reductions. */
+struct Options {
+    /** Number of worker threads, 0 uses `std::thread::hardware_concurrency`. */
+    unsigned threads = 0;
+
+    /**
+     * Use fixed chunking independent of `threads`, so that the result does
+     * not depend on the number of threads.
+     */
+    bool deterministic = false;
+
+    /** Number of elements per chunk in deterministic mode. */
+    std::size_t chunk_size = std::size_t{1} << 16U;
+};
+
+namespace detail {
+
+/**
+ * Partial product stored as the sum of logarithms and the sign.
+ */
+template <typename T>
+struct LogProduct {
+    T log_sum = T(0);
+    bool negative = false;
+    bool null = false;
+
+    /**
+     * Multiply this partial product with the partial product `other`.
+     */
+    void merge(const LogProduct &other) noexcept {
+        this->log_sum += other.log_sum;
+        this->negative = this->negative != other.negative;
+        this->null = this->null || other.null;
+    }
+
+    template <typename V>
+    [[nodiscard]] auto result() const noexcept -> V {
+        using Sign = typename V::Sign;
+
+        if (this->null) {
+            return V::from_log(T(0), Sign::null);
+        }
+        return V::from_log(this->log_sum,
+                           this->negative ? Sign::negative : Sign::positive);
+    }
+};
+
+/**
+ * Serial product of all LogVals in [`first`, `last`).
+ */
+template <typename It>
+[[nodiscard]] auto log_product(It first, It last) {
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using T = decltype(std::declval<value_type>().log_abs());
+
+    LogProduct<T> res;
+    for (; first != last; ++first) {
+        const value_type val = *first;
+        if (val.sign() == value_type::Sign::null) {
+            res.null = true;
+        } else {
+            res.log_sum += val.log_abs();
+            res.negative = res.negative != (val.sign() ==
+                                            value_type::Sign::negative);
+        }
+    }
+    return res;
+}
+
+[[nodiscard]] inline auto thread_count(const Options &options) -> unsigned {
+    if (options.threads != 0) {
+        return options.threads;
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/**
+ * Reduce `size` elements with `reduce(first, last)` (returning a partial
+ * result with a `merge` method) on multiple threads.
+ *
+ * Partial results are stored per chunk and combined in a pairwise tree, so
+ * the order of all operations only depends on the chunking.
+ */
+template <typename Reduce>
+[[nodiscard]] auto parallel_reduce(std::size_t size, const Options &options,
+                                   Reduce reduce) {
+    const unsigned threads = thread_count(options);
+
+    std::size_t chunk_size = 0;
+    if (options.deterministic) {
+        chunk_size = std::max<std::size_t>(options.chunk_size, 1);
+    } else {
+        chunk_size = std::max<std::size_t>((size + threads - 1) / threads, 1);
+    }
+    const std::size_t chunks = std::max<std::size_t>(
+        (size + chunk_size - 1) / chunk_size, 1);
+
+    using Partial = decltype(reduce(std::size_t{0}, std::size_t{0}));
+    std::vector<Partial> partials(chunks);
+
+    std::atomic<std::size_t> next_chunk{0};
+    auto worker = [&]() {
+        for (std::size_t chunk = next_chunk++; chunk < chunks;
+             chunk = next_chunk++) {
+            const std::size_t first = chunk * chunk_size;
+            partials[chunk] =
+                reduce(first, std::min(first + chunk_size, size));
+        }
+    };
+
+    const std::size_t worker_count = std::min<std::size_t>(threads, chunks);
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(worker_count - 1);
+        for (std::size_t i = 1; i < worker_count; ++i) {
+            pool.emplace_back(worker);
+        }
+        worker();
+    }
+
+    for (std::size_t stride = 1; stride < chunks; stride *= 2) {
+        for (std::size_t i = 0; i + stride < chunks; i += 2 * stride) {
+            partials[i].merge(partials[i + stride]);
+        }
+    }
+    return partials.front();
+}
+
+}  // namespace detail
+
+/**
+ * Sum all LogVals in [`first`, `last`) using multiple threads.
+ *
+ * Each chunk is summed with the blocked kernel of `logval::sum`.
+ *
+ * @returns sum of all elements, zero for an empty range.
+ */
+template <std::random_access_iterator It>
+[[nodiscard]] auto sum(It first, It last, const Options &options = {}) ->
+    typename std::iterator_traits<It>::value_type {
+    using value_type = typename std::iterator_traits<It>::value_type;
+
+    const auto size = static_cast<std::size_t>(last - first);
+    return detail::parallel_reduce(
+               size, options,
+               [first](std::size_t begin, std::size_t end) {
+                   return logval::detail::scaled_sum(
+                       first + static_cast<std::ptrdiff_t>(begin),
+                       first + static_cast<std::ptrdiff_t>(end));
+               })
+        .template result<value_type>();
+}
+
+/**
+ * Sum all elements of `values` using multiple threads.
+ *
+ * @returns sum of all elements, zero for an empty array.
+ */
+template <typename T, typename Storage>
+[[nodiscard]] auto sum(const LogValArray<T, Storage> &values,
+                       const Options &options = {}) -> LogVal<T> {
+    return detail::parallel_reduce(
+               values.size(), options,
+               [&values](std::size_t begin, std::size_t end) {
+                   return logval::detail::scaled_sum(values, begin, end);
+               })
+        .template result<LogVal<T>>();
+}
+
+/**
+ * Multiply all LogVals in [`first`, `last`) using multiple threads.
+ *
+ * @returns product of all elements, one for an empty range.
+ */
+template <std::random_access_iterator It>
+[[nodiscard]] auto product(It first, It last, const Options &options = {}) ->
+    typename std::iterator_traits<It>::value_type {
+    using value_type = typename std::iterator_traits<It>::value_type;
+
+    const auto size = static_cast<std::size_t>(last - first);
+    return detail::parallel_reduce(
+               size, options,
+               [first](std::size_t begin, std::size_t end) {
+                   return detail::log_product(
+                       first + static_cast<std::ptrdiff_t>(begin),
+                       first + static_cast<std::ptrdiff_t>(end));
+               })
+        .template result<value_type>();
+}
+
+/**
+ * Dot product of [`first1`, `last1`) and the range starting at `first2`
+ * using multiple threads.
+ *
+ * The products are summed with the blocked kernel of `logval::sum`.
+ *
+ * @returns sum of the element wise products, zero for an empty range.
+ */
+template <std::random_access_iterator It1, std::random_access_iterator It2>
+[[nodiscard]] auto dot(It1 first1, It1 last1, It2 first2,
+                       const Options &options = {}) ->
+    typename std::iterator_traits<It1>::value_type {
+    using value_type = typename std::iterator_traits<It1>::value_type;
+
+    const auto size = static_cast<std::size_t>(last1 - first1);
+    return detail::parallel_reduce(
+               size, options,
+               [first1, first2](std::size_t begin, std::size_t end) {
+                   return logval::detail::scaled_dot(
+                       first1 + static_cast<std::ptrdiff_t>(begin),
+                       first1 + static_cast<std::ptrdiff_t>(end),
+                       first2 + static_cast<std::ptrdiff_t>(begin));
+               })
+        .template result<value_type>();
+}
+
+}  // namespace logval::par
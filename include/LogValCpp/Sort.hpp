@@ -0,0 +1,175 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace logval {
+
+namespace detail {
+
+/** LogVal together with its order key. */
+template <typename V>
+struct Keyed {
+    std::uint64_t key;
+    V value;
+};
+
+/**
+ * Strict weak ordering on keyed values.
+ *
+ * Compares the integer keys and falls back to the (exp-free) LogVal
+ * comparison only for equal keys, which makes the result exact.
+ */
+struct KeyLess {
+    template <typename V>
+    [[nodiscard]] auto operator()(const Keyed<V> &lhs,
+                                  const Keyed<V> &rhs) const noexcept -> bool {
+        if (lhs.key != rhs.key) {
+            return lhs.key < rhs.key;
+        }
+        return lhs.value < rhs.value;
+    }
+};
+
+struct KeyGreater {
+    template <typename V>
+    [[nodiscard]] auto operator()(const Keyed<V> &lhs,
+                                  const Keyed<V> &rhs) const noexcept -> bool {
+        return KeyLess{}(rhs, lhs);
+    }
+};
+
+template <typename It>
+[[nodiscard]] auto make_keyed(It first, It last) {
+    using value_type = typename std::iterator_traits<It>::value_type;
+
+    std::vector<Keyed<value_type>> keyed;
+    keyed.reserve(static_cast<std::size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+        const value_type value = *first;
+        keyed.push_back({value.order_key(), value});
+    }
+    return keyed;
+}
+
+/**
+ * Stable LSD radix sort of `keyed` by key, one byte per pass.
+ *
+ * Passes in which all keys share the same byte are skipped, which is common
+ * for the high bytes of the keys.
+ */
+template <typename V>
+void radix_sort(std::vector<Keyed<V>> &keyed) {
+    constexpr std::size_t radix = 256;
+    constexpr std::size_t passes = sizeof(std::uint64_t);
+
+    std::array<std::array<std::size_t, radix>, passes> counts{};
+    for (const auto &elem : keyed) {
+        for (std::size_t pass = 0; pass < passes; ++pass) {
+            ++counts[pass][(elem.key >> (8 * pass)) & (radix - 1)];
+        }
+    }
+
+    // LogVals are not default constructible, copy to get a buffer instead.
+    std::vector<Keyed<V>> buffer(keyed);
+    for (std::size_t pass = 0; pass < passes; ++pass) {
+        auto &count = counts[pass];
+        if (std::find(count.begin(), count.end(), keyed.size()) !=
+            count.end()) {
+            continue;
+        }
+
+        std::size_t offset = 0;
+        for (auto &bucket : count) {
+            const std::size_t size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+        for (const auto &elem : keyed) {
+            buffer[count[(elem.key >> (8 * pass)) & (radix - 1)]++] = elem;
+        }
+        keyed.swap(buffer);
+    }
+
+    // Keys are not unique for values which differ only in the last bit,
+    // order these (short) runs exactly.
+    for (auto it = keyed.begin(); it != keyed.end();) {
+        const auto run_end =
+            std::find_if(it, keyed.end(), [key = it->key](const auto &elem) {
+                return elem.key != key;
+            });
+        if (std::distance(it, run_end) > 1) {
+            std::sort(it, run_end, KeyLess{});
+        }
+        it = run_end;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Sort the LogVals in [`first`, `last`) in ascending order.
+ *
+ * Radix sorts the values by their `order_key()`, so no floating point
+ * comparisons (and no `exp`) are needed. Works with LogValArray iterators
+ * as well.
+ */
+template <typename It>
+void sort(It first, It last) {
+    auto keyed = detail::make_keyed(first, last);
+    detail::radix_sort(keyed);
+    for (const auto &elem : keyed) {
+        *first = elem.value;
+        ++first;
+    }
+}
+
+/**
+ * Rearrange [`first`, `last`) like `std::nth_element`, but compare integer
+ * keys instead of LogVals.
+ *
+ * After the call `*nth` is the element which would be there if the range
+ * was sorted ascending, no element before is greater and no element after
+ * is smaller.
+ */
+template <typename It>
+void nth_element(It first, It nth, It last) {
+    auto keyed = detail::make_keyed(first, last);
+    std::nth_element(keyed.begin(), keyed.begin() + std::distance(first, nth),
+                     keyed.end(), detail::KeyLess{});
+    for (const auto &elem : keyed) {
+        *first = elem.value;
+        ++first;
+    }
+}
+
+/**
+ * Return the `k` largest LogVals of [`first`, `last`).
+ *
+ * @returns the `k` (or less, if the range is smaller) largest elements in
+ * descending order.
+ */
+template <typename It>
+[[nodiscard]] auto top_k(It first, It last, std::size_t k)
+    -> std::vector<typename std::iterator_traits<It>::value_type> {
+    using value_type = typename std::iterator_traits<It>::value_type;
+
+    auto keyed = detail::make_keyed(first, last);
+    k = std::min(k, keyed.size());
+    const auto kth = keyed.begin() + static_cast<std::ptrdiff_t>(k);
+    std::nth_element(keyed.begin(), kth, keyed.end(), detail::KeyGreater{});
+    std::sort(keyed.begin(), kth, detail::KeyGreater{});
+
+    std::vector<value_type> res;
+    res.reserve(k);
+    std::transform(keyed.begin(), kth, std::back_inserter(res),
+                   [](const auto &elem) { return elem.value; });
+    return res;
+}
+
+}  // namespace logval
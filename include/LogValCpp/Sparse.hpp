@@ -0,0 +1,538 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/Matrix.hpp>
+#include <LogValCpp/Parallel.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Sparse matrices of LogVals.
+ *
+ * Zeros (`Sign::null`) are not stored, hence products cost `O(nnz)` instead
+ * of `O(rows * cols)` `operator+=` calls. `CooMatrix` collects entries in
+ * any order, `CsrMatrix` stores them compressed by rows for the products
+ * `spmv` and `spmm`, which are evaluated with the same scaled kernels as
+ * `gemv` and `gemm`.
+ *
+ * \code
+ * logval::CooMatrix<LogVal<double>> coo(n, n);
+ * coo.add(0, 1, LogVal(0.5));
+ * const logval::CsrMatrix transition(coo);
+ * logval::spmv(transition.transposed(), p.data(), next.data());
+ * \endcode
+ */
+namespace logval {
+
+/**
+ * Sparse matrix of LogVals in coordinate format, for assembling matrices.
+ *
+ * @tparam V element type, e.g. `LogVal<double>`.
+ */
+template <typename V>
+class CooMatrix {
+   public:
+    using value_type = V;
+
+    CooMatrix(std::size_t rows, std::size_t cols) : rows_(rows), cols_(cols) {}
+
+    /**
+     * Sparse copy of the dense matrix `dense`, zeros are dropped.
+     */
+    [[nodiscard]] static auto from_dense(MatrixView<const V> dense)
+        -> CooMatrix {
+        CooMatrix res(dense.rows(), dense.cols());
+        for (std::size_t i = 0; i < dense.rows(); ++i) {
+            for (std::size_t j = 0; j < dense.cols(); ++j) {
+                res.add(i, j, dense(i, j));
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Add the entry `val` at (`row`, `col`), zeros are dropped. Entries at
+     * the same position are summed by the conversion to `CsrMatrix`.
+     */
+    void add(std::size_t row, std::size_t col, const V &val) {
+        if (val.sign() == V::Sign::null) {
+            return;
+        }
+        this->row_indices_.push_back(row);
+        this->col_indices_.push_back(col);
+        this->values_.push_back(val);
+    }
+
+    void reserve(std::size_t nnz) {
+        this->row_indices_.reserve(nnz);
+        this->col_indices_.reserve(nnz);
+        this->values_.reserve(nnz);
+    }
+
+    /**
+     * Dense copy of this matrix in row-major order.
+     */
+    [[nodiscard]] auto to_dense() const -> std::vector<V> {
+        std::vector<V> res(this->rows_ * this->cols_,
+                           V::from_log(typename V::value_type(0),
+                                       V::Sign::null));
+        for (std::size_t k = 0; k < this->values_.size(); ++k) {
+            res[this->row_indices_[k] * this->cols_ +
+                this->col_indices_[k]] += this->values_[k];
+        }
+        return res;
+    }
+
+    [[nodiscard]] auto rows() const noexcept -> std::size_t {
+        return this->rows_;
+    }
+    [[nodiscard]] auto cols() const noexcept -> std::size_t {
+        return this->cols_;
+    }
+    [[nodiscard]] auto nnz() const noexcept -> std::size_t {
+        return this->values_.size();
+    }
+
+    [[nodiscard]] auto row_indices() const noexcept
+        -> std::span<const std::size_t> {
+        return this->row_indices_;
+    }
+    [[nodiscard]] auto col_indices() const noexcept
+        -> std::span<const std::size_t> {
+        return this->col_indices_;
+    }
+    [[nodiscard]] auto values() const noexcept -> std::span<const V> {
+        return this->values_;
+    }
+
+   private:
+    std::size_t rows_;
+    std::size_t cols_;
+    std::vector<std::size_t> row_indices_;
+    std::vector<std::size_t> col_indices_;
+    std::vector<V> values_;
+};
+
+/**
+ * Sparse matrix of LogVals in compressed sparse row format.
+ *
+ * The entries of row `i` are `values()[k]` at column `col_indices()[k]` for
+ * `row_offsets()[i] <= k < row_offsets()[i + 1]`, sorted by column. Zeros
+ * are never stored.
+ *
+ * @tparam V element type, e.g. `LogVal<double>`.
+ */
+template <typename V>
+class CsrMatrix {
+   public:
+    using value_type = V;
+
+    /** Empty matrix of size `rows` x `cols`. */
+    CsrMatrix(std::size_t rows, std::size_t cols)
+        : rows_(rows), cols_(cols), row_offsets_(rows + 1, 0) {}
+
+    /**
+     * Compress `coo`, entries at the same position are summed and dropped if
+     * they cancel.
+     */
+    explicit CsrMatrix(const CooMatrix<V> &coo)
+        : CsrMatrix(coo.rows(), coo.cols()) {
+        const auto rows = coo.row_indices();
+        const auto cols = coo.col_indices();
+        const auto values = coo.values();
+
+        // Counting sort by row, then sort every row by column.
+        std::vector<std::size_t> offsets(this->rows_ + 1, 0);
+        for (const std::size_t row : rows) {
+            ++offsets[row + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<std::size_t> order(values.size());
+        std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+        for (std::size_t k = 0; k < values.size(); ++k) {
+            order[next[rows[k]]++] = k;
+        }
+
+        this->col_indices_.reserve(values.size());
+        this->values_.reserve(values.size());
+        for (std::size_t i = 0; i < this->rows_; ++i) {
+            const auto first = order.begin() +
+                               static_cast<std::ptrdiff_t>(offsets[i]);
+            const auto last = order.begin() +
+                              static_cast<std::ptrdiff_t>(offsets[i + 1]);
+            std::stable_sort(first, last, [&cols](auto lhs, auto rhs) {
+                return cols[lhs] < cols[rhs];
+            });
+            const std::size_t row_start = this->values_.size();
+            for (auto it = first; it != last; ++it) {
+                if (this->values_.size() > row_start &&
+                    this->col_indices_.back() == cols[*it]) {
+                    this->values_.back() += values[*it];
+                } else {
+                    this->col_indices_.push_back(cols[*it]);
+                    this->values_.push_back(values[*it]);
+                }
+            }
+            this->drop_zeros(row_start);
+            this->row_offsets_[i + 1] = this->values_.size();
+        }
+    }
+
+    /**
+     * Sparse copy of the dense matrix `dense`, zeros are dropped.
+     */
+    [[nodiscard]] static auto from_dense(MatrixView<const V> dense)
+        -> CsrMatrix {
+        CsrMatrix res(dense.rows(), dense.cols());
+        for (std::size_t i = 0; i < dense.rows(); ++i) {
+            for (std::size_t j = 0; j < dense.cols(); ++j) {
+                const V val = dense(i, j);
+                if (val.sign() != V::Sign::null) {
+                    res.col_indices_.push_back(j);
+                    res.values_.push_back(val);
+                }
+            }
+            res.row_offsets_[i + 1] = res.values_.size();
+        }
+        return res;
+    }
+
+    /**
+     * Dense copy of this matrix in row-major order.
+     */
+    [[nodiscard]] auto to_dense() const -> std::vector<V> {
+        std::vector<V> res(this->rows_ * this->cols_,
+                           V::from_log(typename V::value_type(0),
+                                       V::Sign::null));
+        for (std::size_t i = 0; i < this->rows_; ++i) {
+            for (std::size_t k = this->row_offsets_[i];
+                 k < this->row_offsets_[i + 1]; ++k) {
+                res[i * this->cols_ + this->col_indices_[k]] =
+                    this->values_[k];
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Transpose of this matrix, e.g. for propagating distributions with a
+     * row-stochastic transition matrix.
+     */
+    [[nodiscard]] auto transposed() const -> CsrMatrix {
+        CsrMatrix res(this->cols_, this->rows_);
+        for (const std::size_t col : this->col_indices_) {
+            ++res.row_offsets_[col + 1];
+        }
+        std::partial_sum(res.row_offsets_.begin(), res.row_offsets_.end(),
+                         res.row_offsets_.begin());
+        res.col_indices_.resize(this->values_.size());
+        res.values_.resize(this->values_.size(),
+                           V::from_log(typename V::value_type(0),
+                                       V::Sign::null));
+        // Rows are visited in order, so the columns of the result are sorted.
+        std::vector<std::size_t> next(res.row_offsets_.begin(),
+                                      res.row_offsets_.end() - 1);
+        for (std::size_t i = 0; i < this->rows_; ++i) {
+            for (std::size_t k = this->row_offsets_[i];
+                 k < this->row_offsets_[i + 1]; ++k) {
+                const std::size_t pos = next[this->col_indices_[k]]++;
+                res.col_indices_[pos] = i;
+                res.values_[pos] = this->values_[k];
+            }
+        }
+        return res;
+    }
+
+    [[nodiscard]] auto rows() const noexcept -> std::size_t {
+        return this->rows_;
+    }
+    [[nodiscard]] auto cols() const noexcept -> std::size_t {
+        return this->cols_;
+    }
+    [[nodiscard]] auto nnz() const noexcept -> std::size_t {
+        return this->values_.size();
+    }
+
+    [[nodiscard]] auto row_offsets() const noexcept
+        -> std::span<const std::size_t> {
+        return this->row_offsets_;
+    }
+    [[nodiscard]] auto col_indices() const noexcept
+        -> std::span<const std::size_t> {
+        return this->col_indices_;
+    }
+    [[nodiscard]] auto values() const noexcept -> std::span<const V> {
+        return this->values_;
+    }
+
+   private:
+    /** Remove entries which cancelled to zero, starting at `first`. */
+    void drop_zeros(std::size_t first) {
+        std::size_t out = first;
+        for (std::size_t k = first; k < this->values_.size(); ++k) {
+            if (this->values_[k].sign() != V::Sign::null) {
+                this->col_indices_[out] = this->col_indices_[k];
+                this->values_[out] = this->values_[k];
+                ++out;
+            }
+        }
+        this->col_indices_.resize(out);
+        this->values_.erase(
+            this->values_.begin() + static_cast<std::ptrdiff_t>(out),
+            this->values_.end());
+    }
+
+    std::size_t rows_;
+    std::size_t cols_;
+    std::vector<std::size_t> row_offsets_;
+    std::vector<std::size_t> col_indices_;
+    std::vector<V> values_;
+};
+
+template <typename V>
+CsrMatrix(const CooMatrix<V> &) -> CsrMatrix<V>;
+
+namespace detail {
+
+/**
+ * `y[i] = sum_k a[i][k] x[k]` for the rows `first <= i < last`.
+ */
+template <typename V>
+void spmv_rows(const CsrMatrix<V> &a, const V *x, V *y, std::size_t first,
+               std::size_t last) {
+    using T = typename V::value_type;
+
+    const auto offsets = a.row_offsets();
+    const auto cols = a.col_indices();
+    const auto values = a.values();
+    std::array<T, sum_block_size> logs{};
+    std::array<bool, sum_block_size> negative{};
+
+    for (std::size_t i = first; i < last; ++i) {
+        ScaledSum<T> res;
+        for (std::size_t offset = offsets[i]; offset < offsets[i + 1];
+             offset += sum_block_size) {
+            const std::size_t count =
+                std::min(sum_block_size, offsets[i + 1] - offset);
+            for (std::size_t k = 0; k < count; ++k) {
+                const V &lhs = values[offset + k];
+                const V &rhs = x[cols[offset + k]];
+                const bool is_null = rhs.sign() == V::Sign::null;
+                logs[k] = is_null ? -std::numeric_limits<T>::infinity()
+                                  : natural_log(lhs) + natural_log(rhs);
+                negative[k] = !is_null && lhs.sign() != rhs.sign();
+            }
+            res.merge(scaled_block_sum(
+                logs.data(), count,
+                [&negative](std::size_t k) { return negative[k]; }));
+        }
+        y[i] = res.template result<V>();
+    }
+}
+
+/**
+ * `B` scaled column by column with its maximum, as for `gemm`.
+ */
+template <typename T, typename VB>
+struct ScaledColumns {
+    MatrixView<VB> matrix;
+    std::vector<T> values;
+    std::vector<T> max;
+
+    explicit ScaledColumns(MatrixView<VB> b)
+        : matrix(b),
+          values(b.rows() * b.cols()),
+          max(b.cols(), -std::numeric_limits<T>::infinity()) {
+        for (std::size_t k = 0; k < b.rows(); ++k) {
+            for (std::size_t j = 0; j < b.cols(); ++j) {
+                max[j] = std::max(max[j], log_or_neg_inf(b(k, j)));
+            }
+        }
+        for (std::size_t k = 0; k < b.rows(); ++k) {
+            for (std::size_t j = 0; j < b.cols(); ++j) {
+                values[k * b.cols() + j] = scaled_value(b(k, j), max[j]);
+            }
+        }
+    }
+};
+
+/**
+ * Rows `first <= i < last` of `C = A B` with a scaled copy of `B`.
+ *
+ * Elements below `reliable_scaled_sum` are recomputed from `b.matrix` like
+ * in `gemm`, as their scaled products may have underflowed.
+ */
+template <typename V, typename T, typename VB, typename VC>
+void spmm_rows(const CsrMatrix<V> &a, const ScaledColumns<T, VB> &b,
+               MatrixView<VC> c, std::size_t first, std::size_t last) {
+    using Sign = typename VC::Sign;
+
+    const std::size_t n = c.cols();
+    const auto offsets = a.row_offsets();
+    const auto cols = a.col_indices();
+    const auto values = a.values();
+    std::vector<T> row(n);
+
+    for (std::size_t i = first; i < last; ++i) {
+        const std::size_t begin = offsets[i];
+        const std::size_t count = offsets[i + 1] - begin;
+        T row_max = -std::numeric_limits<T>::infinity();
+        for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+            row_max = std::max(row_max, natural_log(values[k]));
+        }
+        // Sparse row times dense rows of B, a vectorizable AXPY per entry.
+        std::fill(row.begin(), row.end(), T(0));
+        for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+            const T scale = scaled_value(values[k], row_max);
+            const T *b_row = b.values.data() + cols[k] * n;
+            for (std::size_t j = 0; j < n; ++j) {
+                row[j] += scale * b_row[j];
+            }
+        }
+        const T reliable = reliable_scaled_sum<T>(count);
+        for (std::size_t j = 0; j < n; ++j) {
+            const T val = row[j];
+            if (count == 0 ||
+                b.max[j] == -std::numeric_limits<T>::infinity()) {
+                c(i, j) = VC::from_log(T(0), Sign::null);
+            } else if (std::abs(val) >= reliable) {
+                c(i, j) = from_natural_log<VC>(
+                    row_max + b.max[j] + std::log(std::abs(val)),
+                    val > T(0) ? Sign::positive : Sign::negative);
+            } else {
+                // Products may have underflowed, sum them exactly.
+                c(i, j) = scaled_products<T>(
+                              count,
+                              [&](std::size_t k) { return values[begin + k]; },
+                              [&](std::size_t k) {
+                                  return b.matrix(cols[begin + k], j);
+                              })
+                              .template result<VC>();
+            }
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Sparse matrix vector product `y = A x` of LogVals.
+ *
+ * Every row is reduced with the blocked kernel of `logval::sum`, i.e. the
+ * products are scaled by their maximum, so only one exponential per stored
+ * entry and one logarithm per row are needed.
+ *
+ * @param a sparse matrix of size m x n.
+ * @param x pointer to `n` LogVals.
+ * @param y pointer to `m` LogVals, overwritten with the product.
+ */
+template <typename V>
+void spmv(const CsrMatrix<V> &a, const V *x, V *y) {
+    detail::spmv_rows(a, x, y, 0, a.rows());
+}
+
+/**
+ * Sparse times dense matrix product `C = A B` of LogVals.
+ *
+ * As for `gemm`, the columns of `B` are scaled by their maximum and the
+ * entries of a row of `A` by the row maximum, so a row of `C` is a plain
+ * sum of products of `T` values. Elements which are too small compared to
+ * these maxima to be exact are reduced like in `spmv` instead.
+ *
+ * @param a sparse matrix of size m x k.
+ * @param b matrix of size k x n.
+ * @param c matrix of size m x n, overwritten with the product.
+ */
+template <typename V, typename VB, typename VC>
+    requires std::same_as<std::remove_const_t<VB>, V> &&
+             std::same_as<VC, V>
+void spmm(const CsrMatrix<V> &a, MatrixView<VB> b, MatrixView<VC> c) {
+    using T = typename V::value_type;
+    const detail::ScaledColumns<T, VB> scaled(b);
+    detail::spmm_rows(a, scaled, c, 0, a.rows());
+}
+
+namespace par {
+
+namespace detail {
+
+/**
+ * Split the rows of `a` into at most `threads` ranges of about equal number
+ * of stored entries and call `work(first, last)` for each on its own thread.
+ */
+template <typename V, typename Work>
+void for_row_ranges(const CsrMatrix<V> &a, const Options &options,
+                    Work work) {
+    const auto offsets = a.row_offsets();
+    const std::size_t rows = a.rows();
+    const std::size_t threads =
+        std::min<std::size_t>(thread_count(options),
+                              std::max<std::size_t>(rows, 1));
+
+    std::vector<std::jthread> pool;
+    std::size_t first = 0;
+    for (std::size_t t = 1; t <= threads && first < rows; ++t) {
+        // First row whose entries start at or after the share of thread t.
+        const std::size_t target = a.nnz() * t / threads;
+        std::size_t last =
+            t == threads
+                ? rows
+                : static_cast<std::size_t>(
+                      std::lower_bound(offsets.begin() +
+                                           static_cast<std::ptrdiff_t>(first),
+                                       offsets.end() - 1, target) -
+                      offsets.begin());
+        last = std::max(last, std::min(first + 1, rows));
+        pool.emplace_back([work, first, last]() { work(first, last); });
+        first = last;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Sparse matrix vector product `y = A x` of LogVals using multiple threads.
+ *
+ * The rows are split between the threads by their number of entries, every
+ * element is computed exactly like in `logval::spmv`.
+ */
+template <typename V>
+void spmv(const CsrMatrix<V> &a, const V *x, V *y,
+          const Options &options = {}) {
+    detail::for_row_ranges(a, options,
+                           [&a, x, y](std::size_t first, std::size_t last) {
+                               logval::detail::spmv_rows(a, x, y, first,
+                                                         last);
+                           });
+}
+
+/**
+ * Sparse times dense matrix product `C = A B` of LogVals using multiple
+ * threads, every element is computed exactly like in `logval::spmm`.
+ */
+template <typename V, typename VB, typename VC>
+    requires std::same_as<std::remove_const_t<VB>, V> &&
+             std::same_as<VC, V>
+void spmm(const CsrMatrix<V> &a, MatrixView<VB> b, MatrixView<VC> c,
+          const Options &options = {}) {
+    using T = typename V::value_type;
+    const logval::detail::ScaledColumns<T, VB> scaled(b);
+    detail::for_row_ranges(
+        a, options, [&a, &scaled, c](std::size_t first, std::size_t last) {
+            logval::detail::spmm_rows(a, scaled, c, first, last);
+        });
+}
+
+}  // namespace par
+
+}  // namespace logval
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <LogValCpp/detail/VectorMath.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <span>
+
+namespace logval {
+
+namespace detail {
+
+/**
+ * Partial sum stored as `exp(max) * (positive - negative)`.
+ *
+ * Positive and negative contributions are kept apart, so that cancellation
+ * only happens once when the result is read.
+ */
+template <typename T>
+struct ScaledSum {
+    T max = -std::numeric_limits<T>::infinity();
+    T positive = T(0);
+    T negative = T(0);
+
+    /**
+     * Add the partial sum `other` to this partial sum.
+     */
+    void merge(const ScaledSum &other) noexcept {
+        if (other.max == -std::numeric_limits<T>::infinity()) {
+            return;
+        }
+        if (other.max > this->max) {
+            const T scale = std::exp(this->max - other.max);
+            this->positive = this->positive * scale + other.positive;
+            this->negative = this->negative * scale + other.negative;
+            this->max = other.max;
+        } else {
+            const T scale = std::exp(other.max - this->max);
+            this->positive += other.positive * scale;
+            this->negative += other.negative * scale;
+        }
+    }
+
+    /**
+     * Convert the partial sum into a LogVal (of any policy), this is the
+     * only place where a logarithm is taken.
+     */
+    template <typename V = LogVal<T>>
+    [[nodiscard]] auto result() const noexcept -> V {
+        using Sign = typename V::Sign;
+
+        if (this->positive > this->negative) {
+            return from_natural_log<V>(
+                this->max + std::log(this->positive - this->negative),
+                Sign::positive);
+        }
+        if (this->negative > this->positive) {
+            return from_natural_log<V>(
+                this->max + std::log(this->negative - this->positive),
+                Sign::negative);
+        }
+        return V::from_log(T(0), Sign::null);
+    }
+};
+
+/** Number of elements reduced at once, small enough to stay in L1. */
+inline constexpr std::size_t sum_block_size = 1024;
+
+/** Number of independent accumulators breaking the dependency chain. */
+inline constexpr std::size_t sum_lanes = 8;
+
+/**
+ * Sum `count` (at most `sum_block_size`) contiguous logarithms with signs
+ * given by `is_negative(i)`.
+ *
+ * The block is copied into local buffers, then the maximum is searched,
+ * all values are scaled by it and finally added up in `sum_lanes`
+ * independent accumulators per sign. Each of the loops is free of calls and data dependent branches,
+ * so that the compiler can vectorize them (e.g. with `-mavx2 -mfma` or
+ * `-march=native`).
+ */
+template <typename T, typename IsNegative>
+[[nodiscard]] auto scaled_block_sum(const T *logs, std::size_t count,
+                                    IsNegative is_negative) noexcept
+    -> ScaledSum<T> {
+    // Padding the block to a multiple of `sum_lanes` keeps all loops free of
+    // remainder handling, padded entries are zero (log of -inf).
+    const std::size_t padded = (count + sum_lanes - 1) / sum_lanes * sum_lanes;
+
+    std::array<T, sum_block_size> scaled;
+    std::array<T, sum_block_size> sign;
+    for (std::size_t i = 0; i < count; ++i) {
+        scaled[i] = logs[i];
+        sign[i] = is_negative(i) ? T(1) : T(0);
+    }
+    for (std::size_t i = count; i < padded; ++i) {
+        scaled[i] = -std::numeric_limits<T>::infinity();
+        sign[i] = T(0);
+    }
+
+    std::array<T, sum_lanes> lane_max;
+    lane_max.fill(-std::numeric_limits<T>::infinity());
+    for (std::size_t i = 0; i < padded; i += sum_lanes) {
+        for (std::size_t lane = 0; lane < sum_lanes; ++lane) {
+            lane_max[lane] = scaled[i + lane] > lane_max[lane]
+                                 ? scaled[i + lane]
+                                 : lane_max[lane];
+        }
+    }
+    const T max = *std::max_element(lane_max.begin(), lane_max.end());
+    if (max == -std::numeric_limits<T>::infinity()) {
+        return {};
+    }
+
+    for (std::size_t i = 0; i < padded; ++i) {
+        scaled[i] = exp_nonpositive(scaled[i] - max);
+    }
+
+    std::array<T, sum_lanes> positive{};
+    std::array<T, sum_lanes> negative{};
+    for (std::size_t i = 0; i < padded; i += sum_lanes) {
+        for (std::size_t lane = 0; lane < sum_lanes; ++lane) {
+            positive[lane] += (T(1) - sign[i + lane]) * scaled[i + lane];
+            negative[lane] += sign[i + lane] * scaled[i + lane];
+        }
+    }
+
+    ScaledSum<T> res{max, T(0), T(0)};
+    for (std::size_t lane = 0; lane < sum_lanes; ++lane) {
+        res.positive += positive[lane];
+        res.negative += negative[lane];
+    }
+    return res;
+}
+
+/**
+ * Reduce an arbitrary range of LogVals into a ScaledSum.
+ *
+ * Elements are gathered blockwise into contiguous buffers, which are then
+ * reduced by `scaled_block_sum`.
+ */
+template <typename It>
+[[nodiscard]] auto scaled_sum(It first, It last) {
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using T = decltype(std::declval<value_type>().log_abs());
+
+    std::array<T, sum_block_size> logs{};
+    std::array<bool, sum_block_size> negative{};
+
+    ScaledSum<T> res;
+    while (first != last) {
+        std::size_t count = 0;
+        for (; count < sum_block_size && first != last; ++count, ++first) {
+            const value_type val = *first;
+            logs[count] = val.sign() == value_type::Sign::null
+                              ? -std::numeric_limits<T>::infinity()
+                              : natural_log(val);
+            negative[count] = val.sign() == value_type::Sign::negative;
+        }
+        res.merge(scaled_block_sum(
+            logs.data(), count,
+            [&negative](std::size_t i) { return negative[i]; }));
+    }
+    return res;
+}
+
+/**
+ * Reduce the products of two ranges of LogVals element by element into a
+ * ScaledSum, the second range needs at least as many elements as the first.
+ *
+ * The logarithms of the products are gathered blockwise, so the reduction
+ * uses the same kernel as `scaled_sum`.
+ */
+template <typename It1, typename It2>
+[[nodiscard]] auto scaled_dot(It1 first1, It1 last1, It2 first2) {
+    using value_type = typename std::iterator_traits<It1>::value_type;
+    using T = decltype(std::declval<value_type>().log_abs());
+
+    std::array<T, sum_block_size> logs{};
+    std::array<bool, sum_block_size> negative{};
+
+    ScaledSum<T> res;
+    while (first1 != last1) {
+        std::size_t count = 0;
+        for (; count < sum_block_size && first1 != last1;
+             ++count, ++first1, ++first2) {
+            const value_type lhs = *first1;
+            const value_type rhs = static_cast<value_type>(*first2);
+            const bool is_null = lhs.sign() == value_type::Sign::null ||
+                                 rhs.sign() == value_type::Sign::null;
+            logs[count] = is_null ? -std::numeric_limits<T>::infinity()
+                                  : natural_log(lhs) + natural_log(rhs);
+            negative[count] = !is_null && lhs.sign() != rhs.sign();
+        }
+        res.merge(scaled_block_sum(
+            logs.data(), count,
+            [&negative](std::size_t i) { return negative[i]; }));
+    }
+    return res;
+}
+
+/**
+ * Reduce the elements [`first`, `last`) of a LogValArray into a ScaledSum,
+ * working directly on its log array and sign bits.
+ *
+ * Logarithms stored with less precision than `T` are widened blockwise into
+ * a local buffer first.
+ */
+template <typename T, typename Storage>
+[[nodiscard]] auto scaled_sum(const LogValArray<T, Storage> &values,
+                              std::size_t first, std::size_t last)
+    -> ScaledSum<T> {
+    const auto logs = values.logs();
+    const auto signs = values.sign_bits();
+
+    [[maybe_unused]] std::array<T, sum_block_size> widened;
+    ScaledSum<T> res;
+    for (std::size_t offset = first; offset < last;
+         offset += sum_block_size) {
+        const std::size_t count = std::min(sum_block_size, last - offset);
+        const T *block = nullptr;
+        if constexpr (std::same_as<T, Storage>) {
+            block = logs.data() + offset;
+        } else {
+            for (std::size_t i = 0; i < count; ++i) {
+                widened[i] = static_cast<T>(logs[offset + i]);
+            }
+            block = widened.data();
+        }
+        res.merge(scaled_block_sum(
+            block, count, [&signs, offset](std::size_t i) {
+                const std::size_t index = offset + i;
+                return ((signs[index / 64] >> (index % 64)) & 1U) != 0;
+            }));
+    }
+    return res;
+}
+
+/**
+ * Reduce a LogValArray into a ScaledSum.
+ */
+template <typename T, typename Storage>
+[[nodiscard]] auto scaled_sum(const LogValArray<T, Storage> &values)
+    -> ScaledSum<T> {
+    return scaled_sum(values, 0, values.size());
+}
+
+}  // namespace detail
+
+/**
+ * Sum all LogVals in [`first`, `last`).
+ *
+ * In contrast to `std::accumulate` with `operator+=`, which needs an `exp`
+ * and a `log1p` per element in a serial dependency chain, this function
+ * subtracts the blockwise maximum, sums the scaled values in linear space
+ * and takes a single logarithm at the end. Positive and negative values are
+ * summed separately, so mixed signs are handled correctly.
+ *
+ * @returns sum of all elements, zero for an empty range.
+ */
+template <typename It>
+[[nodiscard]] auto sum(It first, It last) ->
+    typename std::iterator_traits<It>::value_type {
+    using value_type = typename std::iterator_traits<It>::value_type;
+    return detail::scaled_sum(first, last).template result<value_type>();
+}
+
+/**
+ * Sum all LogVals in `values`.
+ *
+ * @returns sum of all elements, zero for an empty span.
+ */
+template <typename T, typename Policy, std::size_t Extent>
+[[nodiscard]] auto sum(std::span<const LogVal<T, Policy>, Extent> values)
+    -> LogVal<T, Policy> {
+    return sum(values.begin(), values.end());
+}
+
+template <typename T, typename Policy, std::size_t Extent>
+[[nodiscard]] auto sum(std::span<LogVal<T, Policy>, Extent> values)
+    -> LogVal<T, Policy> {
+    return sum(values.begin(), values.end());
+}
+
+/**
+ * Sum all elements of `values`.
+ *
+ * Uses the contiguous log array of the container without gathering.
+ *
+ * @returns sum of all elements, zero for an empty array.
+ */
+template <typename T, typename Storage>
+[[nodiscard]] auto sum(const LogValArray<T, Storage> &values) -> LogVal<T> {
+    return detail::scaled_sum(values).result();
+}
+
+}  // namespace logval
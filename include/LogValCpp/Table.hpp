@@ -0,0 +1,48 @@
+#pragma once
+
+#include <LogValCpp/LogVal.hpp>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace logval {
+
+/**
+ * Build the array `{f(0), f(1), ..., f(N - 1)}`.
+ *
+ * Works for element types without default constructor like LogVal and can
+ * be evaluated at compile time, e.g. for Boltzmann weights at a fixed
+ * temperature:
+ * \code
+ * constexpr auto weights = logval::make_table<64>([](std::size_t energy) {
+ *     return LogVal<double>::from_log(-0.5 * static_cast<double>(energy));
+ * });
+ * \endcode
+ */
+template <std::size_t N, typename F>
+[[nodiscard]] constexpr auto make_table(F f)
+    -> std::array<std::invoke_result_t<F &, std::size_t>, N> {
+    return [&f]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<std::invoke_result_t<F &, std::size_t>, N>{
+            f(I)...};
+    }(std::make_index_sequence<N>{});
+}
+
+/**
+ * Table of the factorials `n!` for `n < N`, which can be evaluated at
+ * compile time and does not overflow.
+ */
+template <std::floating_point T = double, std::size_t N>
+[[nodiscard]] constexpr auto factorial_table() -> std::array<LogVal<T>, N> {
+    return make_table<N>([](std::size_t n) {
+        T log_factorial = T(0);
+        for (std::size_t k = 2; k <= n; ++k) {
+            log_factorial += logval::detail::log(static_cast<T>(k));
+        }
+        return LogVal<T>::from_log(log_factorial);
+    });
+}
+
+}  // namespace logval
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace logval::detail {
+
+/**
+ * Minimal allocator returning memory aligned to `Alignment` bytes.
+ *
+ * Used for the contiguous log arrays so that vectorized loops can use aligned
+ * loads and no element straddles a cache line.
+ */
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+   public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    AlignedAllocator(
+        const AlignedAllocator<U, Alignment> & /*other*/) noexcept {}
+
+    [[nodiscard]] auto allocate(std::size_t n) -> T * {
+        return static_cast<T *>(
+            ::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T *ptr, std::size_t /*n*/) noexcept {
+        ::operator delete(ptr, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    auto operator==(const AlignedAllocator<U, Alignment> & /*other*/)
+        const noexcept -> bool {
+        return true;
+    }
+};
+
+}  // namespace logval::detail
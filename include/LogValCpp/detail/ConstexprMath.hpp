@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+namespace logval::detail {
+
+/**
+ * Compile-time replacements for the exponential and logarithm functions of
+ * the standard library, which are not `constexpr` before C++26.
+ *
+ * The functions compute in `long double` and are accurate to about one ulp
+ * of `double`. They are only meant for constant evaluation, at runtime the
+ * dispatchers below call the standard library.
+ */
+namespace constexpr_math {
+
+/** Multiply `val` with `2^exponent`, exact unless the result is subnormal. */
+[[nodiscard]] constexpr auto scale_by_power_of_two(long double val,
+                                                   long long exponent)
+    -> long double {
+    for (; exponent > 0; --exponent) {
+        val *= 2.0L;
+    }
+    for (; exponent < 0; ++exponent) {
+        val *= 0.5L;
+    }
+    return val;
+}
+
+[[nodiscard]] constexpr auto exp(long double x) -> long double {
+    if (x != x) {
+        return x;
+    }
+    if (x == std::numeric_limits<long double>::infinity()) {
+        return x;
+    }
+    if (x == -std::numeric_limits<long double>::infinity()) {
+        return 0.0L;
+    }
+    // Beyond these bounds the result overflows or underflows any type.
+    if (x > 12000.0L) {
+        return std::numeric_limits<long double>::infinity();
+    }
+    if (x < -12000.0L) {
+        return 0.0L;
+    }
+
+    // x = n ln(2) + r with |r| <= ln(2) / 2
+    const long double scaled = x * std::numbers::log2e_v<long double>;
+    const auto n = static_cast<long long>(scaled < 0 ? scaled - 0.5L
+                                                     : scaled + 0.5L);
+    const long double r =
+        x - static_cast<long double>(n) * std::numbers::ln2_v<long double>;
+
+    long double term = 1.0L;
+    long double res = 1.0L;
+    for (int k = 1; k < 40 && res + term != res; ++k) {
+        term *= r / k;
+        res += term;
+    }
+    return scale_by_power_of_two(res, n);
+}
+
+[[nodiscard]] constexpr auto log(long double x) -> long double {
+    if (x != x || x < 0.0L) {
+        return std::numeric_limits<long double>::quiet_NaN();
+    }
+    if (x == 0.0L) {
+        return -std::numeric_limits<long double>::infinity();
+    }
+    if (x == std::numeric_limits<long double>::infinity()) {
+        return x;
+    }
+
+    // x = m 2^e with m in [sqrt(1/2), sqrt(2))
+    long long exponent = 0;
+    while (x >= std::numbers::sqrt2_v<long double>) {
+        x *= 0.5L;
+        ++exponent;
+    }
+    while (x < std::numbers::sqrt2_v<long double> / 2) {
+        x *= 2.0L;
+        --exponent;
+    }
+
+    // log(m) = 2 atanh(s) = 2 (s + s^3 / 3 + s^5 / 5 + ...)
+    const long double s = (x - 1.0L) / (x + 1.0L);
+    const long double s2 = s * s;
+    long double power = s;
+    long double res = s;
+    for (int k = 3; k < 200; k += 2) {
+        power *= s2;
+        const long double next = res + power / k;
+        if (next == res) {
+            break;
+        }
+        res = next;
+    }
+    return 2.0L * res +
+           static_cast<long double>(exponent) *
+               std::numbers::ln2_v<long double>;
+}
+
+[[nodiscard]] constexpr auto log1p(long double x) -> long double {
+    const long double u = 1.0L + x;
+    if (u == 1.0L) {
+        return x;
+    }
+    if (u == std::numeric_limits<long double>::infinity() || x != x) {
+        return log(u);
+    }
+    // Corrects the rounding error of `1 + x`.
+    return log(u) * x / (u - 1.0L);
+}
+
+}  // namespace constexpr_math
+
+/**
+ * `std::exp` which can be used in constant expressions.
+ */
+template <std::floating_point T>
+[[nodiscard]] constexpr auto exp(T x) -> T {
+    if (std::is_constant_evaluated()) {
+        return static_cast<T>(constexpr_math::exp(x));
+    }
+    return std::exp(x);
+}
+
+/**
+ * `std::log` which can be used in constant expressions.
+ */
+template <std::floating_point T>
+[[nodiscard]] constexpr auto log(T x) -> T {
+    if (std::is_constant_evaluated()) {
+        return static_cast<T>(constexpr_math::log(x));
+    }
+    return std::log(x);
+}
+
+/**
+ * `std::log1p` which can be used in constant expressions.
+ */
+template <std::floating_point T>
+[[nodiscard]] constexpr auto log1p(T x) -> T {
+    if (std::is_constant_evaluated()) {
+        return static_cast<T>(constexpr_math::log1p(x));
+    }
+    return std::log1p(x);
+}
+
+/**
+ * `std::exp2` which can be used in constant expressions.
+ */
+template <std::floating_point T>
+[[nodiscard]] constexpr auto exp2(T x) -> T {
+    if (std::is_constant_evaluated()) {
+        return static_cast<T>(constexpr_math::exp(
+            static_cast<long double>(x) * std::numbers::ln2_v<long double>));
+    }
+    return std::exp2(x);
+}
+
+/**
+ * `std::log2` which can be used in constant expressions.
+ */
+template <std::floating_point T>
+[[nodiscard]] constexpr auto log2(T x) -> T {
+    if (std::is_constant_evaluated()) {
+        return static_cast<T>(constexpr_math::log(x) *
+                              std::numbers::log2e_v<long double>);
+    }
+    return std::log2(x);
+}
+
+}  // namespace logval::detail
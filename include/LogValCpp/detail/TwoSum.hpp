@@ -0,0 +1,29 @@
+#pragma once
+
+namespace logval::detail {
+
+/**
+ * Sum of `a` and `b` with its rounding error, `a + b = sum + error` exactly.
+ */
+template <typename T>
+struct TwoSum {
+    T sum;
+    T error;
+};
+
+template <typename T>
+[[nodiscard]] constexpr auto two_sum(T a, T b) noexcept -> TwoSum<T> {
+    const T sum = a + b;
+    const T b_virtual = sum - a;
+    const T a_virtual = sum - b_virtual;
+    return {sum, (a - a_virtual) + (b - b_virtual)};
+}
+
+/** `two_sum` for `|a| >= |b|` (or `a` infinite). */
+template <typename T>
+[[nodiscard]] constexpr auto fast_two_sum(T a, T b) noexcept -> TwoSum<T> {
+    const T sum = a + b;
+    return {sum, b - (sum - a)};
+}
+
+}  // namespace logval::detail
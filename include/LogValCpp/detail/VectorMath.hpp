@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+namespace logval::detail {
+
+/**
+ * `exp(x)` for `x <= 0`, written without calls and data dependent branches.
+ *
+ * The argument is reduced with a Cody-Waite split of `ln(2)`, the remainder
+ * is evaluated with a degree 13 Taylor polynomial and the power of two is
+ * assembled directly in the exponent bits. The maximal error is about one
+ * ulp. Results below `exp(-708)` are flushed to zero, which is fine for
+ * scaled sums where the largest term is one.
+ *
+ * Because the function only consists of arithmetic and selects, compilers
+ * vectorize loops calling it (e.g. to AVX2 or AVX-512 with `-march=native`)
+ * without needing a vector math library.
+ */
+[[nodiscard]] inline auto exp_nonpositive(double x) noexcept -> double {
+    constexpr double log2e = 1.4426950408889634;
+    constexpr double ln2_hi = 0.6931471803691238;
+    constexpr double ln2_lo = 1.9082149292705877e-10;
+    constexpr double min_arg = -708.0;
+    // Adding this constant to an integral double moves it into the low
+    // mantissa bits, which avoids a (not vectorizable) double to int64 cast.
+    constexpr double shift = 0x1.8p52;
+
+    // No clamping, results for `x < min_arg` are garbage and masked below.
+    const double n = std::nearbyint(x * log2e);
+    const double r = (x - n * ln2_hi) - n * ln2_lo;
+
+    double p = 1.0 / 6227020800.0;
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    const std::uint64_t exponent = std::bit_cast<std::uint64_t>(n + shift) -
+                                   std::bit_cast<std::uint64_t>(shift);
+    const double res = p * std::bit_cast<double>((exponent + 1023) << 52);
+
+    // Masking instead of a conditional keeps the loop free of control flow.
+    const std::uint64_t mask = x < min_arg ? 0 : ~std::uint64_t{0};
+    return std::bit_cast<double>(std::bit_cast<std::uint64_t>(res) & mask);
+}
+
+/**
+ * `exp(x)` for `x <= 0` and any floating point type.
+ *
+ * `float` is evaluated in double precision, `long double` falls back to
+ * `std::exp` since it can not be vectorized anyway.
+ */
+template <std::floating_point T>
+[[nodiscard]] inline auto exp_nonpositive(T x) noexcept -> T {
+    if constexpr (std::is_same_v<T, long double>) {
+        return std::exp(x);
+    } else {
+        return static_cast<T>(exp_nonpositive(static_cast<double>(x)));
+    }
+}
+
+}  // namespace logval::detail
@@ -0,0 +1,80 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValAccumulator.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Empty accumulator", "[accumulator]") {
+    const LogValAccumulator<double> acc;
+    REQUIRE(acc.result() == LogVal(0.0));
+}
+
+TEST_CASE("Accumulate single values", "[accumulator]") {
+    auto lhs = GENERATE(1.0, -20000.0, 3.46e9, 0.0);
+    auto rhs = GENERATE(-1.0, 23112.3, -4.46e9, -2.34e7, 0.0);
+
+    LogValAccumulator<double> acc;
+    acc.add(LogVal(lhs));
+    acc += LogVal(rhs);
+
+    REQUIRE_THAT(acc.result().to(),
+                 Catch::Matchers::WithinRel(lhs + rhs, 1e-12));
+}
+
+TEST_CASE("Accumulate with increasing and decreasing magnitudes",
+          "[accumulator]") {
+    LogValAccumulator<double> increasing;
+    LogValAccumulator<double> decreasing;
+    LogVal<double> expected(0.0);
+    for (int i = 0; i < 1000; ++i) {
+        increasing.add(LogVal<double>::from_log(i * 0.5));
+        decreasing.add(LogVal<double>::from_log((999 - i) * 0.5));
+        expected += LogVal<double>::from_log(i * 0.5);
+    }
+
+    REQUIRE_THAT(increasing.result().log_abs(),
+                 Catch::Matchers::WithinRel(expected.log_abs(), 1e-12));
+    REQUIRE_THAT(decreasing.result().log_abs(),
+                 Catch::Matchers::WithinRel(expected.log_abs(), 1e-12));
+}
+
+TEST_CASE("Accumulate with cancellation", "[accumulator]") {
+    LogValAccumulator<double> acc;
+    acc.add(LogVal(5.0));
+    acc.add(LogVal(4.0));
+    acc -= LogVal(5.0);
+    acc -= LogVal(4.0);
+    REQUIRE(acc.result() == LogVal(0.0));
+
+    acc.add(LogVal(-3.0));
+    REQUIRE_THAT(acc.result().to(), Catch::Matchers::WithinRel(-3.0, 1e-12));
+}
+
+TEST_CASE("Merge accumulators", "[accumulator]") {
+    std::vector<LogVal<double>> vec;
+    double expected = 0.0;
+    for (int i = 1; i < 3000; ++i) {
+        const double val = (i % 2 == 0 ? 1.0 : -0.5) * i;
+        vec.emplace_back(val);
+        expected += val;
+    }
+
+    LogValAccumulator<double> first;
+    LogValAccumulator<double> second;
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        (i < vec.size() / 3 ? first : second).add(vec[i]);
+    }
+    first.merge(second);
+    REQUIRE_THAT(first.result().to(),
+                 Catch::Matchers::WithinRel(expected, 1e-12));
+
+    LogValAccumulator<double> bulk;
+    bulk.add(vec.begin(), vec.end());
+    REQUIRE_THAT(bulk.result().to(),
+                 Catch::Matchers::WithinRel(expected, 1e-12));
+
+    bulk.reset();
+    REQUIRE(bulk.result() == LogVal(0.0));
+}
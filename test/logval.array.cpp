@@ -0,0 +1,168 @@
+#include <LogValCpp/LogValArray.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+TEST_CASE("Construction and element access", "[array]") {
+    const std::vector<double> values{-3.0, 0.0, 2.5, 1e30, -1e-30};
+    LogValArray<double> arr(values.size());
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(arr[i] == LogVal(0.0));
+        arr[i] = LogVal(values[i]);
+    }
+
+    REQUIRE(arr.size() == values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(arr[i] == LogVal(values[i]));
+        REQUIRE_THAT(arr[i].to(), Catch::Matchers::WithinRel(values[i]));
+        REQUIRE(arr.is_negative(i) == (values[i] < 0.0));
+    }
+
+    const LogValArray<double> copy(arr.begin(), arr.end());
+    REQUIRE(std::equal(copy.begin(), copy.end(), arr.begin()));
+}
+
+TEST_CASE("Separate storage of logs and signs", "[array]") {
+    LogValArray<double> arr(130, LogVal(-2.0));
+
+    REQUIRE(arr.logs().size() == 130);
+    REQUIRE(arr.sign_bits().size() == 3);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(arr.logs().data()) %
+                LogValArray<double>::alignment ==
+            0);
+
+    for (const auto log_val : arr.logs()) {
+        REQUIRE(log_val == LogVal(-2.0).log_abs());
+    }
+
+    // Writing the logs keeps the signs.
+    arr.logs()[5] = 0.0;
+    REQUIRE(arr[5] == LogVal(-1.0));
+}
+
+TEST_CASE("Zero is independent of the sign", "[array]") {
+    LogValArray<double> arr{LogVal(-1.0), LogVal(1.0)};
+
+    arr[0] += LogVal(1.0);
+    arr[1] *= LogVal(0.0);
+
+    REQUIRE(arr[0] == LogVal(0.0));
+    REQUIRE(arr[1] == LogVal(0.0));
+    REQUIRE_FALSE(arr.is_negative(0));
+}
+
+TEST_CASE("Proxy arithmetic", "[array]") {
+    auto lhs = GENERATE(-3.0, 2.0, 42.0);
+    auto rhs = GENERATE(-1.0, 4.0);
+
+    LogValArray<double> arr{LogVal(lhs), LogVal(rhs)};
+
+    REQUIRE_THAT((arr[0] + arr[1]).to(),
+                 Catch::Matchers::WithinRel(lhs + rhs));
+    REQUIRE_THAT((arr[0] * LogVal(rhs)).to(),
+                 Catch::Matchers::WithinRel(lhs * rhs));
+    REQUIRE_THAT((LogVal(lhs) / arr[1]).to(),
+                 Catch::Matchers::WithinRel(lhs / rhs));
+    REQUIRE((arr[0] < arr[1]) == (lhs < rhs));
+
+    arr[0] -= arr[1];
+    REQUIRE_THAT(arr[0].to(), Catch::Matchers::WithinRel(lhs - rhs));
+}
+
+TEST_CASE("Whole array scaling", "[array]") {
+    LogValArray<double> arr{LogVal(1.0), LogVal(-2.0), LogVal(0.0)};
+
+    arr *= LogVal(-1e200);
+    arr *= LogVal(1e200);
+    arr /= LogVal(-1e300);
+
+    constexpr double eps = 1e-12;
+    REQUIRE_THAT(arr[0].to(), Catch::Matchers::WithinRel(1e100, eps));
+    REQUIRE_THAT(arr[1].to(), Catch::Matchers::WithinRel(-2e100, eps));
+    REQUIRE(arr[2] == LogVal(0.0));
+}
+
+TEST_CASE("Algorithms on LogValArray", "[array][algorithm]") {
+    LogValArray<double> arr;
+    for (int i = 1; i <= 10; ++i) {
+        arr.push_back(LogVal(static_cast<double>(i % 2 == 0 ? i : -i)));
+    }
+
+    SECTION("accumulate") {
+        auto res = std::accumulate(arr.cbegin(), arr.cend(), LogVal(0.0),
+                                   std::plus<>());
+        REQUIRE_THAT(res.to(), Catch::Matchers::WithinAbs(5.0, 1e-9));
+
+        auto res2 = std::accumulate(arr.begin(), arr.end(), LogVal(0.0),
+                                    [](auto acc, auto val) { return acc + val; });
+        REQUIRE(res == res2);
+    }
+
+    SECTION("sort") {
+        std::sort(arr.begin(), arr.end());
+        REQUIRE(std::is_sorted(arr.cbegin(), arr.cend()));
+        REQUIRE(arr[0] == LogVal(-9.0));
+        REQUIRE(arr[9] == LogVal(10.0));
+    }
+
+    SECTION("transform") {
+        std::transform(arr.cbegin(), arr.cend(), arr.begin(),
+                       [](auto val) { return val * val; });
+        for (std::size_t i = 0; i < arr.size(); ++i) {
+            REQUIRE_FALSE(arr.is_negative(i));
+        }
+    }
+}
+
+TEST_CASE("Mixed precision storage", "[array]") {
+    const std::vector<double> values{-3.0, 0.0, 2.5, 1e30, -1e-30, 1e300};
+    LogValArray<double, float> arr(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        arr[i] = LogVal(values[i]);
+    }
+
+    // Logarithms are rounded to float, the magnitude relative to their size.
+    STATIC_REQUIRE(std::same_as<decltype(arr.logs())::value_type, float>);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(arr[i].sign() == LogVal(values[i]).sign());
+        if (values[i] != 0.0) {
+            REQUIRE_THAT(arr[i].log_abs(),
+                         Catch::Matchers::WithinRel(std::log(std::abs(values[i])),
+                                                    1e-7));
+        }
+    }
+
+    // Arithmetic happens in double, so scaling beyond the range of float
+    // exponents works, the intermediate log of about 461 is rounded to float.
+    arr *= LogVal(-1e200);
+    arr /= LogVal(-1e200);
+    REQUIRE_THAT(arr[2].to(), Catch::Matchers::WithinRel(2.5, 1e-4));
+    REQUIRE(arr[1] == LogVal(0.0));
+
+    // Widen and narrow in bulk.
+    const LogValArray<double> wide(arr);
+    const LogValArray<double, float> narrow(wide);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(wide[i] == arr[i]);
+        REQUIRE(narrow[i] == arr[i]);
+    }
+
+    LogValArray<double, float> many;
+    double expected = 0.0;
+    for (int i = 0; i < 3000; ++i) {
+        const double val = std::sin(static_cast<double>(i));
+        many.push_back(LogVal(val));
+        expected += val;
+    }
+    REQUIRE_THAT(logval::sum(many).to(),
+                 Catch::Matchers::WithinAbs(expected, 1e-4));
+}
@@ -0,0 +1,96 @@
+#include <LogValCpp/AtomicLogVal.hpp>
+#include <LogValCpp/LogVal.hpp>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Run `work(thread)` on `threads` threads.
+template <typename Work>
+void run_threads(int threads, Work work) {
+    std::vector<std::jthread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([t, &work] { work(t); });
+    }
+}
+
+}  // namespace
+
+TEST_CASE("AtomicLogVal operations", "[atomic]") {
+    using Sign = LogVal<double>::Sign;
+    if constexpr (sizeof(void *) == sizeof(std::uint64_t)) {
+        STATIC_REQUIRE(AtomicLogVal<double>::is_always_lock_free);
+    }
+    STATIC_REQUIRE(sizeof(AtomicLogVal<double>) == sizeof(std::uint64_t));
+
+    AtomicLogVal<double> val;
+    REQUIRE(val.load().sign() == Sign::null);
+
+    REQUIRE(val.fetch_add(LogVal(2.0)).sign() == Sign::null);
+    REQUIRE_THAT(val.load().to(), Catch::Matchers::WithinRel(2.0, 1e-15));
+    REQUIRE_THAT(val.fetch_mul(LogVal(-3.0)).to(),
+                 Catch::Matchers::WithinRel(2.0, 1e-15));
+    REQUIRE_THAT(val.load().to(), Catch::Matchers::WithinRel(-6.0, 1e-15));
+    val.fetch_sub(val.load());
+    REQUIRE(val.load().sign() == Sign::null);
+
+    val.store(LogVal(5.0));
+    REQUIRE_THAT(val.fetch_max(LogVal(3.0)).to(),
+                 Catch::Matchers::WithinRel(5.0, 1e-15));
+    REQUIRE_THAT(val.load().to(), Catch::Matchers::WithinRel(5.0, 1e-15));
+    val.fetch_max(LogVal(7.0));
+    REQUIRE_THAT(val.load().to(), Catch::Matchers::WithinRel(7.0, 1e-15));
+    REQUIRE_THAT(val.exchange(LogVal(-1.0)).to(),
+                 Catch::Matchers::WithinRel(7.0, 1e-15));
+    val.fetch_max(LogVal(0.0));
+    REQUIRE(val.load().sign() == Sign::null);
+    // Orders with a release part, which loads do not accept.
+    val.fetch_max(LogVal(-2.0), std::memory_order_release);
+    REQUIRE(val.load().sign() == Sign::null);
+    val.fetch_max(LogVal(4.0), std::memory_order_acq_rel);
+    REQUIRE_THAT(val.load().to(), Catch::Matchers::WithinRel(4.0, 1e-15));
+
+    // Beyond the range of double.
+    val.store(LogVal<double>::from_log(800.0));
+    val.fetch_mul(LogVal<double>::from_log(900.0));
+    REQUIRE_THAT(val.load().log_abs(),
+                 Catch::Matchers::WithinRel(1700.0, 1e-15));
+
+    auto expected = LogVal(1.0);
+    REQUIRE(!val.compare_exchange_strong(expected, LogVal(4.0)));
+    REQUIRE(expected == val.load());
+    REQUIRE(val.compare_exchange_strong(expected, LogVal(4.0)));
+    REQUIRE_THAT(val.load().to(), Catch::Matchers::WithinRel(4.0, 1e-15));
+
+    const AtomicLogVal<float, Base2> packed_float(LogVal<float, Base2>(8.0F));
+    REQUIRE(packed_float.load().log_abs() == 3.0F);
+}
+
+TEST_CASE("AtomicLogVal from many threads", "[atomic]") {
+    constexpr int threads = 8;
+    constexpr int updates = 2000;
+
+    AtomicLogVal<double> sum;
+    AtomicLogVal<double> product(LogVal(1.0));
+    AtomicLogVal<double> max;
+    run_threads(threads, [&](int t) {
+        for (int i = 0; i < updates; ++i) {
+            sum.fetch_add(LogVal(1.0), std::memory_order_relaxed);
+            product.fetch_mul(LogVal<double>::from_log(0.5));
+            max.fetch_max(LogVal(static_cast<double>(i * threads + t)));
+        }
+    });
+
+    // Every update is counted, each of them rounds by at most one ulp.
+    REQUIRE_THAT(sum.load().to(),
+                 Catch::Matchers::WithinRel(threads * updates, 1e-11));
+    REQUIRE_THAT(product.load().log_abs(),
+                 Catch::Matchers::WithinRel(0.5 * threads * updates, 1e-11));
+    REQUIRE_THAT(max.load().to(),
+                 Catch::Matchers::WithinRel(threads * updates - 1, 1e-15));
+}
@@ -0,0 +1,112 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <LogValCpp/Matrix.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+using LogVal2 = LogVal<double, Base2>;
+
+TEST_CASE("Base 2 conversion", "[base]") {
+    auto val = GENERATE(-1e200, -3.5, -1.0, 0.0, 1e-300, 0.25, 1.0, 7.0, 1e300);
+
+    const LogVal2 log_val(val);
+    REQUIRE_THAT(log_val.to(), Catch::Matchers::WithinRel(val, 1e-12));
+
+    if (val != 0.0) {
+        REQUIRE(log_val.log_abs() == std::log2(std::abs(val)));
+    } else {
+        REQUIRE(log_val.sign() == LogVal2::Sign::null);
+    }
+}
+
+TEST_CASE("Base 2 arithmetic", "[base]") {
+    auto lhs = GENERATE(-1e10, -2.0, 0.0, 1e-5, 3.0, 1e100);
+    auto rhs = GENERATE(-7.0, 0.0, 0.5, 3.0, 1e99);
+
+    const LogVal2 a(lhs);
+    const LogVal2 b(rhs);
+    const LogVal<double> a_e(lhs);
+    const LogVal<double> b_e(rhs);
+
+    REQUIRE_THAT((a + b).to(),
+                 Catch::Matchers::WithinRel((a_e + b_e).to(), 1e-12));
+    REQUIRE_THAT((a - b).to(),
+                 Catch::Matchers::WithinRel((a_e - b_e).to(), 1e-12));
+    REQUIRE_THAT((a * b).to(),
+                 Catch::Matchers::WithinRel((a_e * b_e).to(), 1e-12));
+    if (rhs != 0.0) {
+        REQUIRE_THAT((a / b).to(),
+                     Catch::Matchers::WithinRel((a_e / b_e).to(), 1e-12));
+    }
+}
+
+TEST_CASE("Explicit base conversion", "[base]") {
+    const auto natural = LogVal<double>::from_log(-2000.0,
+                                                  LogVal<double>::Sign::negative);
+
+    const LogVal2 base2(natural);
+    REQUIRE(base2.sign() == LogVal2::Sign::negative);
+    REQUIRE_THAT(base2.log_abs(),
+                 Catch::Matchers::WithinRel(-2000.0 / std::log(2.0), 1e-15));
+
+    const LogVal<double> back(base2);
+    REQUIRE_THAT(back.log_abs(), Catch::Matchers::WithinRel(-2000.0, 1e-15));
+
+    const LogVal2 zero(LogVal<double>(0.0));
+    REQUIRE(zero.sign() == LogVal2::Sign::null);
+
+    // Same base, the representation is copied unchanged.
+    const LogVal<double, FastMath<16>> fast(natural);
+    REQUIRE(fast.log_abs() == natural.log_abs());
+}
+
+TEST_CASE("Base 2 reductions", "[base]") {
+    std::vector<double> values;
+    for (int i = 0; i < 3000; ++i) {
+        values.push_back(std::sin(static_cast<double>(i)) * 1e3);
+    }
+    std::vector<LogVal2> logs(values.begin(), values.end());
+
+    double expected = 0.0;
+    for (double val : values) {
+        expected += val;
+    }
+    REQUIRE_THAT(logval::sum(logs.begin(), logs.end()).to(),
+                 Catch::Matchers::WithinRel(expected, 1e-10));
+
+    constexpr std::size_t n = 5;
+    std::vector<LogVal2> a(n * n, LogVal2(0.0));
+    std::vector<LogVal2> c(n * n, LogVal2(0.0));
+    for (std::size_t i = 0; i < n * n; ++i) {
+        a[i] = LogVal2(values[i]);
+    }
+    logval::gemm(logval::MatrixView<const LogVal2>(a.data(), n, n),
+                 logval::MatrixView<const LogVal2>(a.data(), n, n),
+                 logval::MatrixView(c.data(), n, n));
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            double ref = 0.0;
+            for (std::size_t k = 0; k < n; ++k) {
+                ref += values[i * n + k] * values[k * n + j];
+            }
+            REQUIRE_THAT(c[i * n + j].to(),
+                         Catch::Matchers::WithinAbs(ref, 1e-9 * 1e6));
+        }
+    }
+}
+
+TEST_CASE("Constexpr base 2", "[base][constexpr]") {
+    constexpr LogVal2 eight(8.0);
+    constexpr LogVal2 four(4.0);
+
+    STATIC_REQUIRE(eight.log_abs() > 2.999999 && eight.log_abs() < 3.000001);
+    STATIC_REQUIRE((eight * four).log_abs() > 4.999999);
+    constexpr double sum = (eight + four).to();
+    STATIC_REQUIRE(sum > 11.999999 && sum < 12.000001);
+}
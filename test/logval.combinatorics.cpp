@@ -0,0 +1,152 @@
+#include <LogValCpp/Combinatorics.hpp>
+#include <LogValCpp/LogVal.hpp>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace combinatorics = logval::combinatorics;
+
+TEST_CASE("Log factorial", "[combinatorics]") {
+    REQUIRE(combinatorics::log_factorial(0) == 0.0);
+    REQUIRE(combinatorics::log_factorial(1) == 0.0);
+    REQUIRE_THAT(combinatorics::log_factorial(10),
+                 Catch::Matchers::WithinRel(std::log(3628800.0), 1e-15));
+
+    // Both sides of the end of the table and far beyond it.
+    for (const std::uint64_t n :
+         {std::uint64_t{20}, std::uint64_t{170}, std::uint64_t{4095},
+          std::uint64_t{4096}, std::uint64_t{65535}, std::uint64_t{65536},
+          std::uint64_t{1000000}, std::uint64_t{1} << 40}) {
+        const long double expected =
+            std::lgamma(static_cast<long double>(n) + 1.0L);
+        INFO(n);
+        REQUIRE_THAT(combinatorics::log_factorial(n),
+                     Catch::Matchers::WithinRel(
+                         static_cast<double>(expected), 1e-15));
+    }
+
+    REQUIRE_THAT(combinatorics::factorial(170).to(),
+                 Catch::Matchers::WithinRel(std::tgamma(171.0), 1e-13));
+    // Far beyond the range of double.
+    REQUIRE(combinatorics::factorial(1000).log_abs() > 5000.0);
+}
+
+TEST_CASE("Binomial coefficients", "[combinatorics]") {
+    REQUIRE_THAT(combinatorics::binomial(5, 2).to(),
+                 Catch::Matchers::WithinRel(10.0, 1e-15));
+    REQUIRE(combinatorics::binomial(10, 0).to() == 1.0);
+    REQUIRE(combinatorics::binomial(10, 10).to() == 1.0);
+    REQUIRE(combinatorics::binomial(3, 4).sign() ==
+            LogVal<double>::Sign::null);
+    REQUIRE(combinatorics::log_binomial(3, 4) ==
+            -std::numeric_limits<double>::infinity());
+    REQUIRE_THAT(combinatorics::binomial(60, 30).to(),
+                 Catch::Matchers::WithinRel(118264581564861424.0, 1e-14));
+
+    // Relative accuracy for small k, where the difference of the factorials
+    // would cancel.
+    for (const std::uint64_t n :
+         {std::uint64_t{1000}, std::uint64_t{100000},
+          std::uint64_t{10000000000}}) {
+        INFO(n);
+        REQUIRE_THAT(combinatorics::log_binomial(n, 1),
+                     Catch::Matchers::WithinRel(
+                         std::log(static_cast<double>(n)), 1e-15));
+        const auto real = static_cast<long double>(n);
+        const auto expected = static_cast<double>(
+            std::log(real * (real - 1.0L) * (real - 2.0L) / 6.0L));
+        REQUIRE_THAT(combinatorics::log_binomial(n, 3),
+                     Catch::Matchers::WithinRel(expected, 1e-14));
+        REQUIRE(combinatorics::log_binomial(n, n - 3) ==
+                combinatorics::log_binomial(n, 3));
+    }
+
+    // Large and balanced.
+    const std::uint64_t n = 1000000;
+    const long double expected = std::lgamma(1000001.0L) -
+                                 2.0L * std::lgamma(500001.0L);
+    REQUIRE_THAT(combinatorics::log_binomial(n, n / 2),
+                 Catch::Matchers::WithinRel(static_cast<double>(expected),
+                                            1e-13));
+
+    // Policies with another base.
+    REQUIRE_THAT((combinatorics::binomial<double, Base2>(5, 2).to()),
+                 Catch::Matchers::WithinRel(10.0, 1e-15));
+}
+
+TEST_CASE("Multinomial coefficients", "[combinatorics]") {
+    REQUIRE_THAT(combinatorics::multinomial(2, 3, 4).to(),
+                 Catch::Matchers::WithinRel(1260.0, 1e-15));
+    const std::array<std::uint64_t, 2> counts{7, 3};
+    REQUIRE_THAT(combinatorics::multinomial(counts).to(),
+                 Catch::Matchers::WithinRel(
+                     combinatorics::binomial(10, 3).to(), 1e-15));
+    REQUIRE(combinatorics::multinomial(5).to() == 1.0);
+    REQUIRE_THAT(
+        (combinatorics::multinomial<float>(100, 200, 300).log_abs()),
+        Catch::Matchers::WithinRel(
+            static_cast<float>(combinatorics::log_factorial(600) -
+                               combinatorics::log_factorial(100) -
+                               combinatorics::log_factorial(200) -
+                               combinatorics::log_factorial(300)),
+            1e-6F));
+}
+
+TEST_CASE("Concurrent log factorial", "[combinatorics]") {
+    std::vector<std::thread> threads;
+    std::vector<int> failures(8, 0);
+    for (std::size_t t = 0; t < failures.size(); ++t) {
+        threads.emplace_back([t, &failures] {
+            for (std::uint64_t n = t; n < 65536; n += 997) {
+                const double expected =
+                    std::lgamma(static_cast<double>(n) + 1.0);
+                const double res = combinatorics::log_factorial(n);
+                if (std::abs(res - expected) > 1e-12 * (1.0 + expected)) {
+                    ++failures[t];
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (const int count : failures) {
+        REQUIRE(count == 0);
+    }
+}
+
+TEST_CASE("Powers and roots", "[combinatorics]") {
+    using Sign = LogVal<double>::Sign;
+    REQUIRE_THAT(logval::pow(LogVal(3.0), 2.0).to(),
+                 Catch::Matchers::WithinRel(9.0, 1e-15));
+    REQUIRE_THAT(logval::pow(LogVal(-2.0), 3.0).to(),
+                 Catch::Matchers::WithinRel(-8.0, 1e-15));
+    REQUIRE_THAT(logval::pow(LogVal(-2.0), -2.0).to(),
+                 Catch::Matchers::WithinRel(0.25, 1e-15));
+    REQUIRE(std::isnan(logval::pow(LogVal(-2.0), 0.5).to()));
+    REQUIRE(logval::pow(LogVal(-2.0), 0.0).to() == 1.0);
+    REQUIRE(logval::pow(LogVal(0.0), 0.0).to() == 1.0);
+    REQUIRE(logval::pow(LogVal(0.0), 2.0).sign() == Sign::null);
+    REQUIRE(std::isinf(logval::pow(LogVal(0.0), -1.0).to()));
+    // Integral exponents convert to the floating point type.
+    REQUIRE_THAT(logval::pow(LogVal(3.0), 2).to(),
+                 Catch::Matchers::WithinRel(9.0, 1e-15));
+    REQUIRE(logval::pow(LogVal(-2.0), 3).sign() == Sign::negative);
+    REQUIRE_THAT(logval::pow(LogVal(2.0F), 3).to(),
+                 Catch::Matchers::WithinRel(8.0F, 1e-6F));
+    // Beyond the range of double.
+    REQUIRE_THAT(combinatorics::pow(LogVal(1e300), 3.0).log_abs(),
+                 Catch::Matchers::WithinRel(900.0 * std::log(10.0), 1e-15));
+
+    REQUIRE_THAT(logval::sqrt(LogVal(16.0)).to(),
+                 Catch::Matchers::WithinRel(4.0, 1e-15));
+    REQUIRE(logval::sqrt(LogVal(0.0)).sign() == Sign::null);
+    REQUIRE(std::isnan(logval::sqrt(LogVal(-1.0)).to()));
+    REQUIRE_THAT(combinatorics::sqrt(LogVal<double, Base2>(2.0)).to(),
+                 Catch::Matchers::WithinRel(std::sqrt(2.0), 1e-15));
+}
@@ -1,4 +1,6 @@
 #include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/PackedLogVal.hpp>
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 #include <catch2/generators/catch_generators_all.hpp>
@@ -6,19 +8,21 @@
 #include <iostream>
 #include <utility>
 
-TEST_CASE("Equal comparision", "[comparision]") {
+TEMPLATE_TEST_CASE("Equal comparision", "[comparision]",
+                   LogVal<double>, PackedLogVal<double>) {
     auto val = GENERATE(0.0, -0.0, 0.01, 2.0, 3456.0, 3.45e7, -2.0, -3.5e11);
 
-    REQUIRE(LogVal(val) == LogVal(val));
+    REQUIRE(TestType(val) == TestType(val));
 
-    const LogVal val1(val);
-    REQUIRE(val1 == LogVal(val));
+    const TestType val1(val);
+    REQUIRE(val1 == TestType(val));
 
-    const LogVal val2(val);
+    const TestType val2(val);
     REQUIRE(val1 == val2);
 }
 
-TEST_CASE("Equal comparision - special cases", "[comparision]") {
+TEMPLATE_TEST_CASE("Equal comparision - special cases", "[comparision]",
+                   LogVal<double>, PackedLogVal<double>) {
     // The comparison requires that std::log(0) == std::log(0)
     REQUIRE(std::log(0) == std::log(0));
 
@@ -26,9 +30,9 @@ TEST_CASE("Equal comparision - special cases", "[comparision]") {
 
     // After multiplication with 0, LogVals must be euqal
     // independently of the initialization.
-    LogVal val1(1.0);
-    LogVal val2(rhs);
-    const LogVal null(0.0);
+    TestType val1(1.0);
+    TestType val2(rhs);
+    const TestType null(0.0);
     val1 *= null;
     val2 *= null;
 
@@ -36,72 +40,79 @@ TEST_CASE("Equal comparision - special cases", "[comparision]") {
 
 }
 
-TEST_CASE("Unequal comparision", "[comparision]") {
+TEMPLATE_TEST_CASE("Unequal comparision", "[comparision]",
+                   LogVal<double>, PackedLogVal<double>) {
     auto lhs = GENERATE(0.0, 0.01, 2.0, 3456.0, 3.45e7);
     auto rhs = GENERATE(0.003, -2.0, -42.0, -2.01e9);
 
-    REQUIRE(LogVal(lhs) != LogVal(rhs));
-    REQUIRE_FALSE(LogVal(lhs) != LogVal(lhs));
-    REQUIRE_FALSE(LogVal(rhs) != LogVal(rhs));
+    REQUIRE(TestType(lhs) != TestType(rhs));
+    REQUIRE_FALSE(TestType(lhs) != TestType(lhs));
+    REQUIRE_FALSE(TestType(rhs) != TestType(rhs));
 
-    const LogVal val1(lhs);
-    REQUIRE(val1 != LogVal(rhs));
-    REQUIRE_FALSE(val1 != LogVal(val1));
+    const TestType val1(lhs);
+    REQUIRE(val1 != TestType(rhs));
+    REQUIRE_FALSE(val1 != TestType(val1));
 
-    const LogVal val2(rhs);
+    const TestType val2(rhs);
     REQUIRE(val1 != val2);
     REQUIRE_FALSE(val1 != val1);
 }
 
-TEST_CASE("operator<=", "[comparision]") {
+TEMPLATE_TEST_CASE("operator<=", "[comparision]",
+                   LogVal<double>, PackedLogVal<double>) {
     using pair = std::pair<double, double>;
     auto [lhs, rhs] = GENERATE(table<double, double>(
         {pair{-5.0, -2.0}, pair{-2.0, 0.0}, pair{-1.0, 1.0}, pair{0.0, 1.0},
          pair{1.0, 3.0}, pair{-1.0, -1.0}, pair{0.0, 0.0}, pair{1.0, 1.0}}));
 
-    REQUIRE(LogVal(lhs) <= LogVal(rhs));
+    REQUIRE(TestType(lhs) <= TestType(rhs));
 }
 
-TEST_CASE("operator<= is false", "[comparision]") {
+TEMPLATE_TEST_CASE("operator<= is false", "[comparision]",
+                   LogVal<double>, PackedLogVal<double>) {
     using pair = std::pair<double, double>;
     auto [rhs, lhs] = GENERATE(table<double, double>(
         {pair{-5.0, -2.0}, pair{-2.0, 0.0}, pair{-1.0, 1.0}, pair{0.0, 1.0},
          pair{1.0, 3.0}}));
 
-    REQUIRE_FALSE(LogVal(lhs) <= LogVal(rhs));
+    REQUIRE_FALSE(TestType(lhs) <= TestType(rhs));
 }
 
-TEST_CASE("operator<", "[comparision]") {
+TEMPLATE_TEST_CASE("operator<", "[comparision]",
+                   LogVal<double>, PackedLogVal<double>) {
     using pair = std::pair<double, double>;
     auto [lhs, rhs] = GENERATE(table<double, double>(
         {pair{-5.0, -2.0}, pair{-2.0, 0.0}, pair{-1.0, 1.0}, pair{0.0, 1.0},
          pair{1.0, 3.0}}));
 
-    REQUIRE(LogVal(lhs) < LogVal(rhs));
+    REQUIRE(TestType(lhs) < TestType(rhs));
 }
 
-TEST_CASE("operator< false", "[comparision]") {
+TEMPLATE_TEST_CASE("operator< false", "[comparision]",
+                   LogVal<double>, PackedLogVal<double>) {
     using pair = std::pair<double, double>;
     auto [rhs, lhs] = GENERATE(table<double, double>(
         {pair{-5.0, -2.0}, pair{-2.0, 0.0}, pair{-1.0, 1.0}, pair{0.0, 1.0},
          pair{1.0, 3.0}, pair{-1.0, -1.0}, pair{0.0, 0.0}, pair{1.0, 1.0}}));
 
-    REQUIRE_FALSE(LogVal(lhs) < LogVal(rhs));
+    REQUIRE_FALSE(TestType(lhs) < TestType(rhs));
 }
 
-TEST_CASE("operator>=", "[comparision]") {
+TEMPLATE_TEST_CASE("operator>=", "[comparision]",
+                   LogVal<double>, PackedLogVal<double>) {
     using pair = std::pair<double, double>;
     auto [lhs, rhs] = GENERATE(table<double, double>(
         {pair{5.0, 2.0}, pair{2.0, 0.0}, pair{1.0, -1.0}, pair{-1.0, -3.0},
          pair{-1.0, -1.0}, pair{0.0, 0.0}, pair{1.0, 1.0}}));
 
-    REQUIRE(LogVal(lhs) >= LogVal(rhs));
+    REQUIRE(TestType(lhs) >= TestType(rhs));
 }
 
-TEST_CASE("operator>", "[comparision]") {
+TEMPLATE_TEST_CASE("operator>", "[comparision]",
+                   LogVal<double>, PackedLogVal<double>) {
     using pair = std::pair<double, double>;
     auto [lhs, rhs] = GENERATE(table<double, double>(
         {pair{5.0, 2.0}, pair{2.0, 0.0}, pair{1.0, -1.0}, pair{-1.0, -3.0}}));
 
-    REQUIRE(LogVal(lhs) > LogVal(rhs));
+    REQUIRE(TestType(lhs) > TestType(rhs));
 }
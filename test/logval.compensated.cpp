@@ -0,0 +1,109 @@
+#include <LogValCpp/CompensatedLogVal.hpp>
+#include <LogValCpp/LogVal.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+TEST_CASE("Compensated arithmetic", "[compensated]") {
+    auto lhs = GENERATE(-20000.0, -2.0, 0.0, 1.0, 3.0, 3.46e9);
+    auto rhs = GENERATE(-4.46e9, -3.0, 0.0, 1.0, 4.0, 23112.3);
+
+    const CompensatedLogVal a(lhs);
+    constexpr double eps = 1e-12;
+
+    auto sum = a;
+    sum += LogVal(rhs);
+    REQUIRE_THAT(sum.to(), Catch::Matchers::WithinRel(lhs + rhs, eps) ||
+                               Catch::Matchers::WithinAbs(lhs + rhs, eps));
+    auto difference = a;
+    difference -= CompensatedLogVal(rhs);
+    REQUIRE_THAT(difference.to(),
+                 Catch::Matchers::WithinRel(lhs - rhs, eps) ||
+                     Catch::Matchers::WithinAbs(lhs - rhs, eps));
+    auto product = a;
+    product *= LogVal(rhs);
+    REQUIRE_THAT(product.to(), Catch::Matchers::WithinRel(lhs * rhs, eps));
+    if (rhs != 0.0) {
+        auto quotient = a;
+        quotient /= LogVal(rhs);
+        REQUIRE_THAT(quotient.to(),
+                     Catch::Matchers::WithinRel(lhs / rhs, eps));
+    }
+
+    auto zero = a;
+    zero -= a;
+    REQUIRE(zero.sign() == LogVal<double>::Sign::null);
+    REQUIRE(zero.value() == LogVal(0.0));
+}
+
+TEST_CASE("Compensated cancellation", "[compensated]") {
+    // 1 + 1e-12 - 1 needs the trailing part of the logarithm.
+    CompensatedLogVal<double> val(1.0);
+    val += LogVal(1e-12);
+    val -= LogVal(1.0);
+    REQUIRE_THAT(val.to(), Catch::Matchers::WithinRel(1e-12, 1e-4));
+
+    val -= LogVal(2e-12);
+    REQUIRE(val.sign() == LogVal<double>::Sign::negative);
+    REQUIRE_THAT(val.to(), Catch::Matchers::WithinRel(-1e-12, 1e-4));
+}
+
+TEST_CASE("Compensated accuracy against long double", "[compensated]") {
+    const auto negative_share = GENERATE(0.0, 0.3);
+    constexpr std::size_t size = 200000;
+
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> magnitude(-3.0, 3.0);
+    std::bernoulli_distribution negative(negative_share);
+
+    // Reference: compensated sum of the values in long double.
+    long double sum = 0.0L;
+    long double compensation = 0.0L;
+    LogVal<double> plain(0.0);
+    LogVal<long double> extended(0.0L);
+    CompensatedLogVal<double> compensated;
+    for (std::size_t i = 0; i < size; ++i) {
+        const double log = magnitude(gen);
+        const bool is_negative = negative(gen);
+
+        const long double val =
+            std::exp(static_cast<long double>(log)) * (is_negative ? -1 : 1);
+        const long double next = sum + val;
+        compensation += std::abs(sum) >= std::abs(val) ? (sum - next) + val
+                                                       : (val - next) + sum;
+        sum = next;
+
+        plain += LogVal<double>::from_log(
+            log, is_negative ? LogVal<double>::Sign::negative
+                             : LogVal<double>::Sign::positive);
+        extended += LogVal<long double>::from_log(
+            log, is_negative ? LogVal<long double>::Sign::negative
+                             : LogVal<long double>::Sign::positive);
+        compensated += LogVal<double>::from_log(
+            log, is_negative ? LogVal<double>::Sign::negative
+                             : LogVal<double>::Sign::positive);
+    }
+    const long double reference = std::log(std::abs(sum + compensation));
+
+    auto error = [reference](long double log) {
+        return static_cast<double>(std::abs(log - reference));
+    };
+    const double plain_error = error(plain.log_abs());
+    const double extended_error = error(extended.log_abs());
+    const double compensated_error =
+        error(static_cast<long double>(compensated.log_hi()) +
+              compensated.log_lo());
+
+    // hi + lo is as accurate as the sum in long double (up to a fraction of
+    // an ulp of double), rounded to double it is at most an ulp off.
+    INFO(plain_error << " " << extended_error << " " << compensated_error);
+    const double ulp = std::nextafter(compensated.log_hi(), 100.0) -
+                       compensated.log_hi();
+    REQUIRE(compensated_error <= extended_error + ulp / 16.0);
+    REQUIRE(error(compensated.value().log_abs()) <= ulp);
+    REQUIRE(plain_error > 10.0 * ulp);
+}
@@ -0,0 +1,127 @@
+#include <LogValCpp/ComplexLogVal.hpp>
+#include <LogValCpp/ComplexLogValArray.hpp>
+#include <LogValCpp/LogVal.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+TEST_CASE("ComplexLogVal conversion", "[complex]") {
+    auto real = GENERATE(0.0, 1.5, -2.0, 1e-200);
+    auto imag = GENERATE(0.0, -3.0, 0.25);
+    const std::complex<double> val(real, imag);
+
+    const ComplexLogVal<double> clv(val);
+    REQUIRE_THAT(clv.to().real(), WithinAbs(real, 1e-14));
+    REQUIRE_THAT(clv.to().imag(), WithinAbs(imag, 1e-14));
+    REQUIRE_THAT(clv.real().to(), WithinAbs(real, 1e-14));
+    REQUIRE_THAT(clv.imag().to(), WithinAbs(imag, 1e-14));
+
+    REQUIRE(ComplexLogVal<double>(LogVal(-2.0)).phase() ==
+            std::numbers::pi);
+    REQUIRE(ComplexLogVal<double>(LogVal(0.0)).is_zero());
+    REQUIRE(ComplexLogVal<double>().is_zero());
+}
+
+TEST_CASE("ComplexLogVal arithmetic", "[complex]") {
+    auto lhs = GENERATE(std::complex<double>(1.0, 2.0),
+                        std::complex<double>(-3.0, 0.5),
+                        std::complex<double>(-1.0, 0.0),
+                        std::complex<double>(0.0, 0.0));
+    auto rhs = GENERATE(std::complex<double>(0.5, -1.0),
+                        std::complex<double>(-1e5, -1e-3),
+                        std::complex<double>(-1.0, 0.0),
+                        std::complex<double>(0.0, 0.0));
+
+    const ComplexLogVal<double> clhs(lhs);
+    const ComplexLogVal<double> crhs(rhs);
+
+    auto check = [](std::complex<double> res, std::complex<double> expected) {
+        const double tol = 1e-12 * std::max(1.0, std::abs(expected));
+        REQUIRE_THAT(res.real(), WithinAbs(expected.real(), tol));
+        REQUIRE_THAT(res.imag(), WithinAbs(expected.imag(), tol));
+    };
+
+    check((clhs * crhs).to(), lhs * rhs);
+    check((clhs + crhs).to(), lhs + rhs);
+    check((clhs - crhs).to(), lhs - rhs);
+    check((-clhs).to(), -lhs);
+    check(clhs.conj().to(), std::conj(lhs));
+    if (rhs != std::complex<double>(0.0)) {
+        check((clhs / crhs).to(), lhs / rhs);
+    }
+    if (lhs == std::complex<double>(0.0)) {
+        // Zero is stored with phase zero, also as a quotient.
+        REQUIRE(clhs / crhs == ComplexLogVal<double>());
+        REQUIRE((clhs / crhs).phase() == 0.0);
+    }
+}
+
+TEST_CASE("ComplexLogVal beyond the range of double", "[complex]") {
+    const auto big = ComplexLogVal<double>::from_log(2000.0, 1.0);
+    const auto res = big * big;
+    REQUIRE(res.log_abs() == 4000.0);
+    REQUIRE_THAT(res.phase(), WithinAbs(2.0, 1e-15));
+
+    // exp(2000) (e^i + e^-i) = 2 cos(1) exp(2000)
+    const auto sum = big + big.conj();
+    REQUIRE_THAT(sum.log_abs(),
+                 WithinRel(2000.0 + std::log(2 * std::cos(1.0)), 1e-14));
+    REQUIRE_THAT(sum.phase(), WithinAbs(0.0, 1e-15));
+    REQUIRE(sum.imag().to() == 0.0);
+
+    REQUIRE((big - big).is_zero());
+}
+
+TEST_CASE("ComplexLogValArray", "[complex]") {
+    const std::vector<std::complex<double>> values{
+        {1.0, 2.0}, {-3.0, 0.5}, {0.0, 0.0}, {-1.0, -1e-3}};
+    ComplexLogValArray<double> arr(values);
+    REQUIRE(arr.size() == values.size());
+
+    const auto converted = arr.to();
+    std::complex<double> expected_sum(0.0);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE_THAT(converted[i].real(), WithinAbs(values[i].real(), 1e-14));
+        REQUIRE_THAT(converted[i].imag(), WithinAbs(values[i].imag(), 1e-14));
+        expected_sum += values[i];
+    }
+
+    const auto sum = logval::sum(arr);
+    REQUIRE_THAT(sum.to().real(), WithinAbs(expected_sum.real(), 1e-14));
+    REQUIRE_THAT(sum.to().imag(), WithinAbs(expected_sum.imag(), 1e-14));
+    REQUIRE(logval::sum(ComplexLogValArray<double>()).is_zero());
+
+    const ComplexLogValArray<double> copy = arr;
+    arr *= copy;
+    arr *= ComplexLogVal<double>(std::complex<double>(0.0, -2.0));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const auto expected =
+            values[i] * values[i] * std::complex<double>(0.0, -2.0);
+        REQUIRE_THAT(arr[i].to().real(), WithinAbs(expected.real(), 1e-13));
+        REQUIRE_THAT(arr[i].to().imag(), WithinAbs(expected.imag(), 1e-13));
+        REQUIRE(arr[i].phase() > -std::numbers::pi);
+        REQUIRE(arr[i].phase() <= std::numbers::pi);
+    }
+
+    arr /= copy;
+    REQUIRE_THAT(arr[0].to().real(), WithinAbs(4.0, 1e-13));
+    REQUIRE_THAT(arr[0].to().imag(), WithinAbs(-2.0, 1e-13));
+    REQUIRE(arr[2] == ComplexLogVal<double>());
+
+    // Phases written far outside of (-pi, pi] are wrapped by the operators.
+    ComplexLogValArray<double> unwrapped(
+        std::vector<std::complex<double>>{{1.0, 0.0}, {1.0, 0.0}});
+    unwrapped.phases()[0] = 0.5 + 20.0 * std::numbers::pi;
+    unwrapped.phases()[1] = -0.5 - 7.0 * std::numbers::pi;
+    unwrapped *= ComplexLogVal<double>(std::complex<double>(1.0, 0.0));
+    REQUIRE_THAT(unwrapped.phases()[0], WithinAbs(0.5, 1e-13));
+    REQUIRE_THAT(unwrapped.phases()[1],
+                 WithinAbs(std::numbers::pi - 0.5, 1e-13));
+}
@@ -0,0 +1,80 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <LogValCpp/Table.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+TEST_CASE("Constexpr math matches the standard library", "[constexpr]") {
+    auto val = GENERATE(1e-300, 1e-10, 0.3, 1.0, 2.5, 1234.5, 1e300);
+
+    constexpr double eps = std::numeric_limits<double>::epsilon();
+    REQUIRE_THAT(static_cast<double>(logval::detail::constexpr_math::log(val)),
+                 Catch::Matchers::WithinRel(std::log(val), 2 * eps));
+    REQUIRE_THAT(
+        static_cast<double>(logval::detail::constexpr_math::log1p(val)),
+        Catch::Matchers::WithinRel(std::log1p(val), 2 * eps));
+
+    auto arg = GENERATE(-700.0, -20.0, -1e-10, 0.0, 0.7, 300.0);
+    REQUIRE_THAT(static_cast<double>(logval::detail::constexpr_math::exp(arg)),
+                 Catch::Matchers::WithinRel(std::exp(arg), 2 * eps));
+
+    STATIC_REQUIRE(logval::detail::log(0.0) ==
+                   -std::numeric_limits<double>::infinity());
+    STATIC_REQUIRE(logval::detail::exp(
+                       -std::numeric_limits<double>::infinity()) == 0.0);
+    STATIC_REQUIRE(logval::detail::log(1.0) == 0.0);
+}
+
+TEST_CASE("Constexpr LogVal arithmetic", "[constexpr]") {
+    constexpr LogVal<double> two(2.0);
+    constexpr LogVal<double> three(3.0);
+    constexpr LogVal<double> minus_four(-4.0);
+    constexpr LogVal<double> zero(0.0);
+
+    STATIC_REQUIRE(zero.sign() == LogVal<double>::Sign::null);
+    STATIC_REQUIRE(minus_four.sign() == LogVal<double>::Sign::negative);
+    STATIC_REQUIRE(two < three);
+    STATIC_REQUIRE(minus_four < zero);
+    STATIC_REQUIRE((two * three).log_abs() == two.log_abs() + three.log_abs());
+    STATIC_REQUIRE((two - two) == zero);
+
+    constexpr auto sum = two + three;
+    constexpr auto diff = two + minus_four;
+    using FastLogVal = LogVal<double, FastMath<1024>>;
+    constexpr auto fast_sum = FastLogVal(2.0) + FastLogVal(3.0);
+    constexpr auto value = (two * three / minus_four).to();
+
+    REQUIRE_THAT(sum.to(), Catch::Matchers::WithinRel(5.0, 1e-15));
+    REQUIRE_THAT(diff.to(), Catch::Matchers::WithinRel(-2.0, 1e-15));
+    REQUIRE_THAT(fast_sum.to(), Catch::Matchers::WithinRel(5.0, 1e-15));
+    REQUIRE_THAT(value, Catch::Matchers::WithinRel(-1.5, 1e-15));
+
+    // Identical to the runtime results up to rounding.
+    REQUIRE_THAT(sum.log_abs(),
+                 Catch::Matchers::WithinRel(
+                     (LogVal(2.0) + LogVal(3.0)).log_abs(), 1e-15));
+}
+
+TEST_CASE("Compile-time tables", "[constexpr]") {
+    constexpr auto factorials = logval::factorial_table<double, 200>();
+    STATIC_REQUIRE(factorials.size() == 200);
+    STATIC_REQUIRE(factorials[0] == LogVal<double>::from_log(0.0));
+
+    REQUIRE_THAT(factorials[10].to(),
+                 Catch::Matchers::WithinRel(3628800.0, 1e-14));
+    // 199! is beyond the range of double
+    REQUIRE_THAT(factorials[199].log_abs(),
+                 Catch::Matchers::WithinRel(std::lgamma(200.0), 1e-14));
+
+    constexpr double beta = 0.5;
+    constexpr auto weights = logval::make_table<16>([](std::size_t energy) {
+        return LogVal<double>::from_log(-beta * static_cast<double>(energy));
+    });
+    STATIC_REQUIRE(weights[4].log_abs() == -2.0);
+    REQUIRE_THAT(weights[2].to(),
+                 Catch::Matchers::WithinRel(std::exp(-1.0), 1e-15));
+}
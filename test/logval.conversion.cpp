@@ -16,3 +16,18 @@ TEST_CASE("To type", "[conversion]") {
     REQUIRE(LogVal<float>(1.0F).to<float>() == 1.0F);
     REQUIRE(LogVal<float>(-1.0F).to<float>() == -1.0F);
 }
+
+TEST_CASE("Logarithm and sign access", "[conversion]") {
+    auto val = GENERATE(-3.5, -1.0, 0.0, 1.0, 2e100);
+
+    const LogVal log_val(val);
+    REQUIRE(log_val.log_abs() == std::log(std::abs(val)));
+
+    const auto copy = LogVal<double>::from_log(log_val.log_abs(), log_val.sign());
+    REQUIRE(copy == log_val);
+
+    REQUIRE(LogVal<double>::from_log(1.0, LogVal<double>::Sign::null) ==
+            LogVal(0.0));
+    REQUIRE(LogVal<double>::from_log(0.0, LogVal<double>::Sign::negative) ==
+            LogVal(-1.0));
+}
@@ -0,0 +1,113 @@
+// Built into `counter_tests` with LOGVAL_ENABLE_COUNTERS defined for all of
+// its translation units.
+#ifndef LOGVAL_ENABLE_COUNTERS
+#error "logval.counters.cpp is built by counter_tests only"
+#endif
+
+#include <LogValCpp/Counters.hpp>
+#include <LogValCpp/LogVal.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+using V = LogVal<double>;
+
+}  // namespace
+
+TEST_CASE("Count additions and subtractions", "[counters]") {
+    logval::reset_counters();
+    REQUIRE(logval::counters() == logval::Counters{});
+
+    V val(1.0);
+    val += V(2.0);
+    val += V(-0.5);
+    val -= V(1.0);
+    val *= V(3.0);
+
+    const auto counts = logval::counters();
+    REQUIRE(counts.additions == 1);
+    REQUIRE(counts.subtractions == 2);
+    REQUIRE(counts.cancellations == 0);
+    REQUIRE(counts.ignored_terms == 0);
+
+    // Adding zero or to zero needs no kernel.
+    V zero(0.0);
+    zero += V(1.0);
+    zero += V(0.0);
+    REQUIRE(logval::counters().additions == 1);
+}
+
+TEST_CASE("Count cancellations and ignored terms", "[counters]") {
+    logval::reset_counters();
+
+    V val(3.0);
+    val -= V(3.0);
+    REQUIRE(val.sign() == V::Sign::null);
+
+    V large(1e20);
+    large += V(1.0);
+    large -= V(1e-3);
+    large += V(1e10);
+
+    const auto counts = logval::counters();
+    REQUIRE(counts.cancellations == 1);
+    REQUIRE(counts.ignored_terms == 2);
+    REQUIRE(counts.additions == 2);
+    REQUIRE(counts.subtractions == 1);
+}
+
+TEST_CASE("Count overflowing and underflowing conversions", "[counters]") {
+    logval::reset_counters();
+
+    REQUIRE(V(2.0).to() == 2.0);
+    REQUIRE(V::from_log(1000.0).to() == std::numeric_limits<double>::infinity());
+    REQUIRE(V::from_log(-1000.0).to() == 0.0);
+    REQUIRE(V::from_log(100.0).to<float>() ==
+            std::numeric_limits<float>::infinity());
+    REQUIRE(V(0.0).to() == 0.0);
+    REQUIRE(V::from_log(std::numeric_limits<double>::infinity()).to() ==
+            std::numeric_limits<double>::infinity());
+
+    const auto counts = logval::counters();
+    REQUIRE(counts.overflows == 2);
+    REQUIRE(counts.underflows == 1);
+}
+
+TEST_CASE("Counters are per thread", "[counters]") {
+    logval::reset_counters();
+    V val(1.0);
+    val += V(1.0);
+
+    logval::Counters other;
+    std::thread thread([&other] {
+        V inner(1.0);
+        inner += V(1.0);
+        inner += V(1.0);
+        other = logval::counters();
+    });
+    thread.join();
+
+    REQUIRE(logval::counters().additions == 1);
+    REQUIRE(other.additions == 2);
+
+    auto total = logval::counters();
+    total += other;
+    REQUIRE(total.additions == 3);
+
+    std::ostringstream os;
+    logval::dump_counters(os);
+    REQUIRE(os.str().find("additions:     1\n") != std::string::npos);
+
+    logval::reset_counters();
+    REQUIRE(logval::counters() == logval::Counters{});
+}
+
+TEST_CASE("Counting keeps LogVal constexpr", "[counters]") {
+    constexpr auto sum = V(2.0) + V(3.0);
+    constexpr auto difference = V(2.0) - V(2.0);
+    STATIC_REQUIRE(sum.sign() == V::Sign::positive);
+    STATIC_REQUIRE(difference.sign() == V::Sign::null);
+}
@@ -0,0 +1,102 @@
+#include <LogValCpp/Expression.hpp>
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstddef>
+
+using logval::lazy;
+
+TEST_CASE("Lazy sum of products", "[expression]") {
+    auto a = GENERATE(-3.0, 0.0, 0.5, 2.0);
+    auto b = GENERATE(-1.5, 0.0, 4.0);
+    auto c = GENERATE(-2.0, 7.0);
+    constexpr double d = 0.25;
+    constexpr double e = -1.0;
+
+    const LogVal<double> res =
+        lazy(LogVal(a)) * LogVal(b) + LogVal(c) * LogVal(d) + LogVal(e);
+    const double expected = a * b + c * d + e;
+
+    REQUIRE_THAT(res.to(), Catch::Matchers::WithinAbs(expected, 1e-12) ||
+                               Catch::Matchers::WithinRel(expected, 1e-14));
+}
+
+TEST_CASE("Lazy expression structure", "[expression]") {
+    const LogVal a(2.0);
+    const LogVal b(3.0);
+    const LogVal c(-5.0);
+
+    const auto expr = lazy(a) * (lazy(b) + c) - a;
+    STATIC_REQUIRE(decltype(expr)::term_count == 3);
+    REQUIRE_THAT(expr.to(), Catch::Matchers::WithinRel(2.0 * (3.0 - 5.0) - 2.0,
+                                                       1e-14));
+    REQUIRE_THAT(logval::eval(-expr).to(), Catch::Matchers::WithinRel(6.0, 1e-14));
+
+    // Products are exact sums of logarithms.
+    const auto product = lazy(a) * b * c;
+    STATIC_REQUIRE(decltype(product)::term_count == 1);
+    REQUIRE(product.eval() == a * b * c);
+    REQUIRE((lazy(a) * LogVal(0.0)).eval() == LogVal(0.0));
+
+    // Exact cancellation.
+    REQUIRE((lazy(a) * b - LogVal(6.0)).eval().sign() ==
+            LogVal<double>::Sign::null);
+    REQUIRE((lazy(LogVal(0.0)) + LogVal(0.0)).eval() == LogVal(0.0));
+}
+
+TEST_CASE("Lazy sums beyond the range of double", "[expression]") {
+    const auto huge = LogVal<double>::from_log(5000.0);
+    const auto tiny = LogVal<double>::from_log(-5000.0);
+
+    const LogVal<double> res = lazy(huge) * huge + huge * tiny - huge;
+    REQUIRE_THAT(res.log_abs(), Catch::Matchers::WithinRel(10000.0, 1e-15));
+
+    const LogVal<double> small = lazy(huge) * tiny + tiny * tiny;
+    REQUIRE_THAT(small.to(), Catch::Matchers::WithinRel(1.0, 1e-14));
+}
+
+TEST_CASE("Lazy sum is more accurate than chained additions", "[expression]") {
+    // Errors of the logarithm against a long double reference, accumulated
+    // over many sums of eight positive terms.
+    double fused_error = 0.0;
+    double chained_error = 0.0;
+    for (int trial = 0; trial < 1000; ++trial) {
+        std::array<LogVal<double>, 8> terms{
+            LogVal(0.0), LogVal(0.0), LogVal(0.0), LogVal(0.0),
+            LogVal(0.0), LogVal(0.0), LogVal(0.0), LogVal(0.0)};
+        long double reference = 0.0L;
+        for (std::size_t i = 0; i < terms.size(); ++i) {
+            const double log = std::sin(trial * 8.0 + static_cast<double>(i));
+            terms[i] = LogVal<double>::from_log(log);
+            reference += std::exp(static_cast<long double>(log));
+        }
+
+        const LogVal<double> fused = lazy(terms[0]) + terms[1] + terms[2] +
+                                     terms[3] + terms[4] + terms[5] +
+                                     terms[6] + terms[7];
+        LogVal<double> chained = terms[0];
+        for (std::size_t i = 1; i < terms.size(); ++i) {
+            chained += terms[i];
+        }
+
+        const long double log_reference = std::log(reference);
+        fused_error += static_cast<double>(
+            std::abs(static_cast<long double>(fused.log_abs()) -
+                     log_reference));
+        chained_error += static_cast<double>(
+            std::abs(static_cast<long double>(chained.log_abs()) -
+                     log_reference));
+    }
+
+    REQUIRE(fused_error < chained_error);
+}
+
+TEST_CASE("Lazy expressions with other policies", "[expression]") {
+    using LogVal2 = LogVal<double, Base2>;
+    const LogVal2 res = lazy(LogVal2(3.0)) * LogVal2(4.0) + LogVal2(-2.0);
+    REQUIRE_THAT(res.to(), Catch::Matchers::WithinRel(10.0, 1e-14));
+}
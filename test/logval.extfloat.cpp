@@ -0,0 +1,136 @@
+#include <LogValCpp/ExtFloat.hpp>
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <limits>
+
+TEST_CASE("ExtFloat construction", "[extfloat]") {
+    using Sign = ExtFloat<double>::Sign;
+    const ExtFloat<double> zero;
+    REQUIRE(zero.mantissa() == 0.0);
+    REQUIRE(zero.exponent() == 0);
+    REQUIRE(zero.sign() == Sign::null);
+    REQUIRE(ExtFloat(-0.0) == zero);
+
+    const ExtFloat val(-12.0);
+    REQUIRE(val.mantissa() == -0.75);
+    REQUIRE(val.exponent() == 4);
+    REQUIRE(val.sign() == Sign::negative);
+    REQUIRE(val.to() == -12.0);
+
+    REQUIRE(ExtFloat<double>::from_parts(3.0, 10) == ExtFloat(3072.0));
+    REQUIRE(ExtFloat(std::numeric_limits<double>::denorm_min()).to() ==
+            std::numeric_limits<double>::denorm_min());
+    REQUIRE(std::isinf(
+        ExtFloat(std::numeric_limits<double>::infinity()).to()));
+    REQUIRE(std::isnan(
+        ExtFloat(std::numeric_limits<double>::quiet_NaN()).to()));
+
+    // Outside of the range of double.
+    const auto huge = ExtFloat<double>::from_parts(0.5, 5000);
+    REQUIRE(std::isinf(huge.to()));
+    REQUIRE(ExtFloat<double>::from_parts(0.5, -5000).to() == 0.0);
+    REQUIRE(huge.to<long double>() == std::ldexp(0.5L, 5000));
+}
+
+TEST_CASE("ExtFloat arithmetic", "[extfloat]") {
+    auto lhs = GENERATE(-3.5, -1e-3, 0.0, 0.25, 7.0, 1e100);
+    auto rhs = GENERATE(-2.0, 0.0, 1e-5, 3.5, 1e90);
+    const ExtFloat ext_lhs(lhs);
+    const ExtFloat ext_rhs(rhs);
+
+    REQUIRE((ext_lhs + ext_rhs).to() == lhs + rhs);
+    REQUIRE((ext_lhs - ext_rhs).to() == lhs - rhs);
+    REQUIRE((ext_lhs * ext_rhs).to() == lhs * rhs);
+    if (rhs != 0.0) {
+        REQUIRE((ext_lhs / ext_rhs).to() == lhs / rhs);
+    }
+    REQUIRE((ext_lhs < ext_rhs) == (lhs < rhs));
+    REQUIRE((ext_lhs == ext_rhs) == (lhs == rhs));
+    REQUIRE((ext_lhs >= ext_rhs) == (lhs >= rhs));
+    REQUIRE((-ext_lhs).to() == -lhs);
+}
+
+TEST_CASE("ExtFloat of float and long double", "[extfloat]") {
+    // Bit manipulation for float, `frexp` and `ldexp` for long double.
+    const ExtFloat lhs_float(-3.5F);
+    const ExtFloat rhs_float(1e-3F);
+    REQUIRE((lhs_float + rhs_float).to() == -3.5F + 1e-3F);
+    REQUIRE((lhs_float * rhs_float).to() == -3.5F * 1e-3F);
+    REQUIRE(ExtFloat(1e-40F).to() == 1e-40F);
+
+    const ExtFloat lhs_long(-3.5L);
+    const ExtFloat rhs_long(1e-3L);
+    REQUIRE((lhs_long + rhs_long).to() == -3.5L + 1e-3L);
+    REQUIRE((lhs_long / rhs_long).to() == -3.5L / 1e-3L);
+    REQUIRE(lhs_long.mantissa() == -0.875L);
+    REQUIRE(lhs_long.exponent() == 2);
+}
+
+TEST_CASE("ExtFloat beyond the range of double", "[extfloat]") {
+    // 1e-200^4 underflows double.
+    ExtFloat<double> product(1.0);
+    for (int i = 0; i < 4; ++i) {
+        product *= ExtFloat(1e-200);
+    }
+    REQUIRE(product.exponent() < -2600);
+    REQUIRE_THAT(product.to_logval().log_abs(),
+                 Catch::Matchers::WithinRel(-800.0 * std::log(10.0), 1e-15));
+
+    // Negligible terms leave the sum unchanged.
+    const auto sum = product + ExtFloat(1.0);
+    REQUIRE(sum.to() == 1.0);
+
+    const auto small = product + product;
+    REQUIRE(small.exponent() == product.exponent() + 1);
+    REQUIRE(small.mantissa() == product.mantissa());
+    REQUIRE((small - product - product).sign() ==
+            ExtFloat<double>::Sign::null);
+    REQUIRE(product < small);
+    REQUIRE(-small < -product);
+    REQUIRE(ExtFloat(0.0) < product);
+    REQUIRE(ExtFloat(-1.0) < product);
+}
+
+TEST_CASE("ExtFloat conversion from and to LogVal", "[extfloat]") {
+    auto log = GENERATE(-1e6, -745.5, -3.0, -1e-12, 0.0, 0.7, 42.0, 1e5,
+                        1e12);
+    for (const auto sign :
+         {LogVal<double>::Sign::positive, LogVal<double>::Sign::negative}) {
+        const auto val = LogVal<double>::from_log(log, sign);
+        const ExtFloat<double> ext(val);
+        REQUIRE(ext.sign() == val.sign());
+
+        const auto back = ext.to_logval();
+        REQUIRE(back.sign() == val.sign());
+        // One rounding to double for each direction, relative to the value.
+        REQUIRE(std::abs(back.log_abs() - log) <=
+                std::max(4.0 * std::numeric_limits<double>::epsilon(),
+                         std::abs(log) *
+                             std::numeric_limits<double>::epsilon()));
+    }
+
+    // Base two is converted without rounding.
+    const auto base2 = LogVal<double, Base2>::from_log(-12345.25);
+    const ExtFloat<double> ext(base2);
+    REQUIRE(ext.exponent() == -12345);
+    REQUIRE_THAT(ext.mantissa(),
+                 Catch::Matchers::WithinULP(std::exp2(0.75) / 2.0, 1));
+    REQUIRE(ext.to_logval<Base2>().log_abs() == -12345.25);
+
+    REQUIRE(ExtFloat<double>(LogVal(0.0)).sign() ==
+            ExtFloat<double>::Sign::null);
+    REQUIRE(ExtFloat<double>().to_logval().sign() ==
+            LogVal<double>::Sign::null);
+    REQUIRE_THAT(ExtFloat<double>(LogVal(3.0)).to(),
+                 Catch::Matchers::WithinULP(3.0, 2));
+
+    // Logarithms beyond the exponent saturate.
+    REQUIRE(std::isinf(
+        ExtFloat<double>(LogVal<double>::from_log(1e300)).to()));
+    REQUIRE(ExtFloat<double>(LogVal<double>::from_log(-1e300)).sign() ==
+            ExtFloat<double>::Sign::null);
+}
@@ -0,0 +1,147 @@
+#include <LogValCpp/FFT.hpp>
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+auto make_values(std::size_t size) -> std::vector<LogVal<double>> {
+    std::vector<LogVal<double>> res;
+    for (std::size_t i = 0; i < size; ++i) {
+        res.emplace_back(std::sin(1.0 + static_cast<double>(i)) * (i % 4));
+    }
+    return res;
+}
+
+// O(n^2) reference transform
+auto direct_dft(const std::vector<LogVal<double>> &values)
+    -> std::vector<std::complex<double>> {
+    const std::size_t size = values.size();
+    std::vector<std::complex<double>> res(size);
+    for (std::size_t k = 0; k < size; ++k) {
+        for (std::size_t j = 0; j < size; ++j) {
+            res[k] += values[j].to() *
+                      std::polar(1.0, -2.0 * std::numbers::pi *
+                                          static_cast<double>((j * k) % size) /
+                                          static_cast<double>(size));
+        }
+    }
+    return res;
+}
+
+}  // namespace
+
+TEST_CASE("Forward and inverse FFT", "[fft]") {
+    auto size = GENERATE(std::size_t{1}, std::size_t{2}, std::size_t{8},
+                         std::size_t{12}, std::size_t{13}, std::size_t{64});
+
+    const auto values = make_values(size);
+    const auto expected = direct_dft(values);
+    const auto spectrum = logval::fft::forward(values.begin(), values.end());
+
+    REQUIRE(spectrum.size() == size);
+    for (std::size_t k = 0; k < size; ++k) {
+        REQUIRE_THAT(spectrum.real(k).to(),
+                     Catch::Matchers::WithinAbs(expected[k].real(), 1e-12));
+        REQUIRE_THAT(spectrum.imag(k).to(),
+                     Catch::Matchers::WithinAbs(expected[k].imag(), 1e-12));
+    }
+
+    const auto restored = logval::fft::inverse(spectrum);
+    for (std::size_t j = 0; j < size; ++j) {
+        REQUIRE_THAT(restored.real(j).to(),
+                     Catch::Matchers::WithinAbs(values[j].to(), 1e-12));
+        REQUIRE_THAT(restored.imag(j).to(),
+                     Catch::Matchers::WithinAbs(0.0, 1e-12));
+    }
+}
+
+TEST_CASE("Real input FFT", "[fft]") {
+    auto size = GENERATE(std::size_t{0}, std::size_t{1}, std::size_t{2},
+                         std::size_t{9}, std::size_t{10}, std::size_t{32});
+
+    const auto values = make_values(size);
+    const auto expected = direct_dft(values);
+    const auto spectrum =
+        logval::fft::forward_real(values.begin(), values.end());
+
+    REQUIRE(spectrum.size() == (size == 0 ? 0 : size / 2 + 1));
+    for (std::size_t k = 0; k < spectrum.size(); ++k) {
+        REQUIRE_THAT(spectrum.real(k).to(),
+                     Catch::Matchers::WithinAbs(expected[k].real(), 1e-12));
+        REQUIRE_THAT(spectrum.imag(k).to(),
+                     Catch::Matchers::WithinAbs(expected[k].imag(), 1e-12));
+    }
+
+    const auto restored = logval::fft::inverse_real(spectrum, size);
+    REQUIRE(restored.size() == size);
+    for (std::size_t j = 0; j < size; ++j) {
+        REQUIRE_THAT(restored[j].to(),
+                     Catch::Matchers::WithinAbs(values[j].to(), 1e-12));
+    }
+}
+
+TEST_CASE("FFT beyond the range of double", "[fft]") {
+    // exp(1000) * (1, 2, 3, 4)
+    const auto scale = LogVal<double>::from_log(1000.0);
+    const std::vector<LogVal<double>> values{
+        LogVal(1.0) * scale, LogVal(2.0) * scale, LogVal(3.0) * scale,
+        LogVal(4.0) * scale};
+
+    const auto spectrum = logval::fft::forward(values.begin(), values.end());
+    REQUIRE_THAT(spectrum.log_abs(0),
+                 Catch::Matchers::WithinRel(1000.0 + std::log(10.0), 1e-12));
+    REQUIRE(spectrum.real(2).sign() == LogVal<double>::Sign::negative);
+    REQUIRE_THAT(spectrum.real(2).log_abs(),
+                 Catch::Matchers::WithinRel(1000.0 + std::log(2.0), 1e-12));
+
+    const auto restored = logval::fft::inverse(spectrum);
+    for (std::size_t j = 0; j < values.size(); ++j) {
+        REQUIRE_THAT(restored.real(j).log_abs(),
+                     Catch::Matchers::WithinRel(values[j].log_abs(), 1e-12));
+    }
+}
+
+TEST_CASE("Convolution", "[fft]") {
+    const std::vector<LogVal<double>> empty;
+    REQUIRE(logval::fft::convolve(empty.begin(), empty.end(), empty.begin(),
+                                  empty.end())
+                .size() == 0);
+
+    // Density of states of n independent two level systems is binomial.
+    const auto scale = LogVal<double>::from_log(-800.0);
+    std::vector<LogVal<double>> dos{scale, scale};
+    for (int i = 1; i < 10; ++i) {
+        const std::vector<LogVal<double>> two_level{LogVal(1.0), LogVal(1.0)};
+        const auto res = logval::fft::convolve(dos.begin(), dos.end(),
+                                               two_level.begin(),
+                                               two_level.end());
+        dos.assign(res.begin(), res.end());
+    }
+
+    REQUIRE(dos.size() == 11);
+    double binomial = 1.0;
+    for (std::size_t k = 0; k < dos.size(); ++k) {
+        REQUIRE_THAT(dos[k].log_abs(),
+                     Catch::Matchers::WithinRel(-800.0 + std::log(binomial),
+                                                1e-12));
+        binomial = binomial * static_cast<double>(10 - k) /
+                   static_cast<double>(k + 1);
+    }
+
+    const LogValArray<double> arr{LogVal(1.0), LogVal(-2.0), LogVal(3.0)};
+    const auto res =
+        logval::fft::convolve(arr.begin(), arr.end(), arr.begin(), arr.end());
+    const std::vector<double> expected{1.0, -4.0, 10.0, -12.0, 9.0};
+    REQUIRE(res.size() == expected.size());
+    for (std::size_t k = 0; k < expected.size(); ++k) {
+        REQUIRE_THAT(res[k].to(),
+                     Catch::Matchers::WithinAbs(expected[k], 1e-12));
+    }
+}
@@ -0,0 +1,185 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <LogValCpp/LogValFile.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <LogValCpp/PackedLogVal.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+namespace {
+
+auto temp_file(const char *name) -> std::filesystem::path {
+    return std::filesystem::temp_directory_path() / name;
+}
+
+auto make_values(std::size_t count) -> LogValArray<double> {
+    LogValArray<double> res;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double val = i % 5 == 0 ? 0.0 : std::sin(static_cast<double>(i));
+        res.push_back(LogVal(val) * LogVal<double>::from_log(
+                                        static_cast<double>(i % 3) * 1000.0));
+    }
+    return res;
+}
+
+}  // namespace
+
+TEST_CASE("Structure of arrays file round trip", "[file]") {
+    const auto path = temp_file("logval.file.soa.bin");
+    // More values than one chunk of the writer and not a multiple of 64.
+    const auto values = make_values(logval::io::Writer<>::chunk_size + 77);
+
+    REQUIRE(logval::io::write(path, values));
+
+    const auto header = logval::io::read_header(path);
+    REQUIRE(header);
+    REQUIRE(header->count == values.size());
+    REQUIRE(header->layout == logval::io::Layout::soa);
+    REQUIRE(header->value_type == logval::io::ValueType::float64);
+
+    const auto file = logval::io::MappedFile<double>::open(path);
+    REQUIRE(file);
+    REQUIRE(file->size() == values.size());
+    REQUIRE(file->packed().empty());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(file->logs()[i] == values.logs()[i]);
+        REQUIRE((*file)[i] == values[i]);
+    }
+    for (std::size_t i = 0; i < values.sign_bits().size(); ++i) {
+        REQUIRE(file->sign_bits()[i] == values.sign_bits()[i]);
+    }
+
+    // The type of the logarithms is checked.
+    REQUIRE_FALSE(logval::io::MappedFile<float>::open(path));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Packed file round trip", "[file]") {
+    const auto path = temp_file("logval.file.packed.bin");
+    const auto array = make_values(1000);
+    const std::vector<PackedLogVal<double>> values(array.begin(), array.end());
+
+    REQUIRE(logval::io::write(path,
+                              std::span<const PackedLogVal<double>>(values)));
+
+    const auto file = logval::io::MappedFile<double>::open(path);
+    REQUIRE(file);
+    REQUIRE(file->layout() == logval::io::Layout::packed);
+    REQUIRE(file->logs().empty());
+    REQUIRE(file->packed().size() == values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(file->packed()[i] == values[i]);
+        REQUIRE(PackedLogVal(file->get(i)) == values[i]);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Streaming writer", "[file]") {
+    const auto path = temp_file("logval.file.stream.bin");
+    {
+        auto writer = logval::io::Writer<float>::open(path);
+        REQUIRE(writer);
+        // Base 2 values are stored with natural logarithms.
+        writer->write(LogVal<double, Base2>(8.0));
+        writer->write(LogVal(-2.0));
+        writer->write(LogVal(0.0));
+        REQUIRE(writer->size() == 3);
+        // Closed by the destructor.
+    }
+
+    const auto file = logval::io::MappedFile<float>::open(path);
+    REQUIRE(file);
+    REQUIRE(file->size() == 3);
+    REQUIRE_THAT(file->get<double>(0).to(),
+                 Catch::Matchers::WithinRel(8.0, 1e-6));
+    REQUIRE_THAT(file->get<double>(1).to(),
+                 Catch::Matchers::WithinRel(-2.0, 1e-6));
+    REQUIRE(file->get(2) == LogVal(0.0F));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Invalid files are rejected", "[file]") {
+    const auto path = temp_file("logval.file.invalid.bin");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "LogVal(1.5)\n";
+    }
+    REQUIRE_FALSE(logval::io::read_header(path));
+    REQUIRE_FALSE(logval::io::MappedFile<double>::open(path));
+    REQUIRE_FALSE(logval::io::MappedFile<double>::open(
+        temp_file("logval.file.missing.bin")));
+
+    // Truncated data.
+    REQUIRE(logval::io::write(path, make_values(100)));
+    std::filesystem::resize_file(path, 64 + 8 * 50);
+    REQUIRE(logval::io::read_header(path));
+    REQUIRE_FALSE(logval::io::MappedFile<double>::open(path));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Corrupt counts are rejected", "[file]") {
+    const auto path = temp_file("logval.file.corrupt.bin");
+    const auto values = make_values(100);
+    const std::vector<PackedLogVal<double>> packed(values.begin(),
+                                                   values.end());
+    if (GENERATE(true, false)) {
+        REQUIRE(logval::io::write(path, values));
+    } else {
+        REQUIRE(logval::io::write(
+            path, std::span<const PackedLogVal<double>>(packed)));
+    }
+
+    // Counts whose size in bytes wraps around to a small size.
+    const auto count = GENERATE(std::uint64_t{1} << 61U,
+                                (std::uint64_t{1} << 61U) + 1,
+                                ~std::uint64_t{0});
+    {
+        std::fstream file(path,
+                          std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offsetof(logval::io::FileHeader, count));
+        file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    }
+    REQUIRE(logval::io::read_header(path)->count == count);
+    REQUIRE_FALSE(logval::io::MappedFile<double>::open(path));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Arrays appended to a streaming writer", "[file]") {
+    const auto path = temp_file("logval.file.append.bin");
+    const auto first = make_values(128);
+    const auto second = make_values(30);
+    {
+        auto writer = logval::io::Writer<double>::open(path);
+        REQUIRE(writer);
+        writer->write(first);
+        writer->write(second);
+        writer->write(first);
+        REQUIRE(writer->close());
+    }
+
+    const auto file = logval::io::MappedFile<double>::open(path);
+    REQUIRE(file);
+    REQUIRE(file->size() == 2 * first.size() + second.size());
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        REQUIRE(file->get(i) == first[i]);
+        REQUIRE(file->get(first.size() + second.size() + i) == first[i]);
+    }
+    for (std::size_t i = 0; i < second.size(); ++i) {
+        REQUIRE(file->get(first.size() + i) == second[i]);
+    }
+
+    std::filesystem::remove(path);
+}
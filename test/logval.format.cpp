@@ -0,0 +1,190 @@
+#include <LogValCpp/Format.hpp>
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <limits>
+#include <string_view>
+#include <system_error>
+
+namespace {
+
+template <typename T, typename Policy>
+auto format(const LogVal<T, Policy> &val) -> std::string_view {
+    static std::array<char, 64> buffer{};
+    const auto res =
+        logval::to_chars(buffer.data(), buffer.data() + buffer.size(), val);
+    REQUIRE(res.ec == std::errc{});
+    return {buffer.data(), static_cast<std::size_t>(res.ptr - buffer.data())};
+}
+
+template <typename T, typename Policy = ExactMath>
+auto parse(std::string_view text) -> LogVal<T, Policy> {
+    LogVal<T, Policy> val(T(42));
+    const auto res =
+        logval::from_chars(text.data(), text.data() + text.size(), val);
+    REQUIRE(res.ec == std::errc{});
+    REQUIRE(res.ptr == text.data() + text.size());
+    return val;
+}
+
+}  // namespace
+
+TEST_CASE("Format values", "[format]") {
+    REQUIRE(format(LogVal(0.0)) == "0e+00");
+    REQUIRE(format(LogVal(1.0)) == "1e+00");
+    REQUIRE(format(LogVal(-2.5)) == "-2.5e+00");
+    REQUIRE(format(LogVal(1234.0)) == "1.234e+03");
+    REQUIRE(format(LogVal(0.001)) == "1e-03");
+    REQUIRE(format(LogVal(1e300) * LogVal(1e300)) == "1e+600");
+    REQUIRE(format(LogVal<double>::from_log(
+                std::numeric_limits<double>::infinity())) == "inf");
+    REQUIRE(format(LogVal<double>::from_log(
+                std::numeric_limits<double>::quiet_NaN(),
+                LogVal<double>::Sign::negative)) == "-nan");
+
+    std::array<char, 64> buffer{};
+    const auto res = logval::to_chars(
+        buffer.data(), buffer.data() + buffer.size(), LogVal(-3.14159), 2);
+    REQUIRE(std::string_view(buffer.data(), res.ptr) == "-3.14e+00");
+
+    // Digits beyond the precision of long double are zeros.
+    std::array<char, 128> wide_buffer{};
+    const auto wide_res =
+        logval::to_chars(wide_buffer.data(),
+                         wide_buffer.data() + wide_buffer.size(),
+                         LogVal(1.5), 50);
+    REQUIRE(wide_res.ec == std::errc{});
+    const std::string_view wide_text(wide_buffer.data(), wide_res.ptr);
+    REQUIRE(wide_text.size() == 2 + 50 + 4);
+    REQUIRE(wide_text.starts_with("1.500000000000000"));
+    REQUIRE(wide_text.ends_with("0000000000e+00"));
+    REQUIRE(logval::to_chars(wide_buffer.data(),
+                             wide_buffer.data() + wide_buffer.size(),
+                             LogVal(1.5), 200)
+                .ec == std::errc::value_too_large);
+
+    // Too small buffers are reported.
+    REQUIRE(logval::to_chars(buffer.data(), buffer.data() + 4, LogVal(-2.5))
+                .ec == std::errc::value_too_large);
+}
+
+TEST_CASE("Parse values", "[format]") {
+    const auto val = parse<double>("-3.14159e+123456");
+    REQUIRE(val.sign() == LogVal<double>::Sign::negative);
+    REQUIRE_THAT(val.log_abs(),
+                 Catch::Matchers::WithinRel(
+                     std::log(3.14159) + 123456.0 * std::log(10.0), 1e-15));
+
+    REQUIRE(parse<double>("2.5").to() == 2.5);
+    REQUIRE(parse<double>("250E-2").to() == 2.5);
+    REQUIRE(parse<double>("0.00025e+4").to() == 2.5);
+    REQUIRE(parse<double>("1").to() == 1.0);
+    REQUIRE(parse<double>("0").sign() == LogVal<double>::Sign::null);
+    REQUIRE(parse<double>("-0.000e5").sign() == LogVal<double>::Sign::null);
+    REQUIRE(parse<double>("inf").log_abs() ==
+            std::numeric_limits<double>::infinity());
+    REQUIRE(std::isnan(parse<double>("-NaN").log_abs()));
+
+    // Trailing characters end the number.
+    LogVal<double> out(1.0);
+    const std::string_view text = "12e1x";
+    auto res = logval::from_chars(text.data(), text.data() + text.size(), out);
+    REQUIRE(res.ec == std::errc{});
+    REQUIRE(*res.ptr == 'x');
+    REQUIRE_THAT(out.to(), Catch::Matchers::WithinRel(120.0, 1e-15));
+
+    auto invalid = GENERATE(as<std::string_view>{}, "", "-", ".", "e5", "x1");
+    res = logval::from_chars(invalid.data(), invalid.data() + invalid.size(),
+                             out);
+    REQUIRE(res.ec == std::errc::invalid_argument);
+    REQUIRE(res.ptr == invalid.data());
+
+    const std::string_view huge = "1e9999999999999999";
+    res = logval::from_chars(huge.data(), huge.data() + huge.size(), out);
+    REQUIRE(res.ec == std::errc::result_out_of_range);
+    REQUIRE_THAT(out.to(), Catch::Matchers::WithinRel(120.0, 1e-15));
+}
+
+TEST_CASE("Format huge logarithms", "[format]") {
+    using Sign = LogVal<double>::Sign;
+    std::array<char, 64> buffer{};
+
+    // Without digits after the point of the logarithm, but exact.
+    for (const double large :
+         {5e15, -5e15, 9e15, -9e15, 0x1p52 + 2.0, -0x1p53 - 2.0, 1.03e16}) {
+        const auto text = format(LogVal<double>::from_log(large));
+        INFO(text);
+        REQUIRE(parse<double>(text).log_abs() == large);
+        const auto text2 = format(LogVal<double, Base2>::from_log(large));
+        INFO(text2);
+        REQUIRE(parse<double, Base2>(text2).log_abs() == large);
+    }
+
+    // Decimal exponents which `from_chars` can not read back, or which do
+    // not even fit into 64 bits.
+    auto log = GENERATE(1.04e16, -1.1e16, 3e18, 2.2e19, -1e300,
+                        std::numeric_limits<double>::max());
+    auto sign = GENERATE(Sign::positive, Sign::negative);
+    const auto res =
+        logval::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                         LogVal<double>::from_log(log, sign));
+    REQUIRE(res.ec == std::errc::result_out_of_range);
+    REQUIRE(res.ptr == buffer.data());
+    REQUIRE(logval::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                             LogVal<double>::from_log(log, sign), 3)
+                .ec == std::errc::result_out_of_range);
+    REQUIRE(logval::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                             LogVal<float>::from_log(
+                                 std::numeric_limits<float>::max()))
+                .ec == std::errc::result_out_of_range);
+}
+
+TEST_CASE("Format round trip", "[format]") {
+    // Logarithms close to zero and other bases need an extended
+    // `long double`.
+    constexpr bool extended = std::numeric_limits<long double>::digits > 53;
+    auto scale = GENERATE(1e-10, 0.5, 3.0, 50.0, 1e3, 1e5, 1e9, 1e14);
+    for (int i = 0; i < 500; ++i) {
+        const double log = std::sin(static_cast<double>(i) * 1.7) * scale;
+        const auto sign = i % 3 == 0 ? LogVal<double>::Sign::negative
+                                     : LogVal<double>::Sign::positive;
+        const auto val = LogVal<double>::from_log(log, sign);
+        const auto text = format(val);
+        const auto parsed = parse<double>(text);
+
+        INFO(text);
+        REQUIRE(parsed.sign() == val.sign());
+
+        using Base2Sign = LogVal<double, Base2>::Sign;
+        const auto base2 = LogVal<double, Base2>::from_log(
+            log, i % 3 == 0 ? Base2Sign::negative : Base2Sign::positive);
+        const auto text2 = format(base2);
+        INFO(text2);
+        if (extended) {
+            REQUIRE(parse<double, Base2>(text2) == base2);
+        }
+
+        if (extended || std::abs(log) >= 3.0) {
+            REQUIRE(parsed.log_abs() == val.log_abs());
+        } else {
+            REQUIRE_THAT(parsed.log_abs(),
+                         Catch::Matchers::WithinULP(val.log_abs(), 1));
+        }
+    }
+}
+
+TEST_CASE("Format round trip of float", "[format]") {
+    for (int i = 0; i < 500; ++i) {
+        const auto log = static_cast<float>(std::sin(i * 1.3) * 1e4);
+        const auto val = LogVal<float>::from_log(log);
+        const auto text = format(val);
+
+        INFO(text);
+        REQUIRE(parse<float>(text).log_abs() == val.log_abs());
+    }
+    REQUIRE(format(LogVal(0.5F)) == "5e-01");
+}
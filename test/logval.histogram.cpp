@@ -0,0 +1,89 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValHistogram.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Histogram single threaded", "[histogram]") {
+    LogValHistogram<double> hist(4);
+    REQUIRE(hist.size() == 4);
+    REQUIRE(hist[0] == LogVal(0.0));
+
+    hist.add(0, LogVal(2.0));
+    hist.add(0, LogVal(-0.5));
+    REQUIRE_THAT(hist[0].to(), Catch::Matchers::WithinRel(1.5, 1e-15));
+
+    hist.add(1, LogVal(-3.0));
+    REQUIRE(hist[1].sign() == LogVal<double>::Sign::negative);
+    REQUIRE_THAT(hist[1].to(), Catch::Matchers::WithinRel(-3.0, 1e-15));
+
+    hist.set(2, LogVal<double>::from_log(1000.0));
+    const auto res = hist.multiply(2, LogVal<double>::from_log(500.0));
+    REQUIRE(res == hist[2]);
+    REQUIRE_THAT(hist[2].log_abs(), Catch::Matchers::WithinRel(1500.0, 1e-15));
+
+    hist.add(3, LogVal(1.0));
+    hist.add(3, LogVal(-1.0));
+    REQUIRE(hist[3] == LogVal(0.0));
+
+    hist.reset(LogVal(2.0));
+    REQUIRE_THAT(hist[1].to(), Catch::Matchers::WithinRel(2.0, 1e-15));
+}
+
+TEST_CASE("Histogram snapshot, normalization and flatness", "[histogram]") {
+    LogValHistogram<double> hist(3, LogVal(1.0));
+    REQUIRE(hist.is_flat(0.8));
+
+    hist.set(1, LogVal(0.5));
+    // mean = 2.5 / 3, 0.8 * mean = 0.667 > 0.5
+    REQUIRE_FALSE(hist.is_flat(0.8));
+    REQUIRE(hist.is_flat(0.5));
+
+    const auto snapshot = hist.snapshot();
+    REQUIRE(snapshot.size() == 3);
+    REQUIRE_THAT(snapshot[1].to(), Catch::Matchers::WithinRel(0.5, 1e-15));
+
+    const auto normalized = hist.normalized();
+    REQUIRE_THAT(normalized[0].to(), Catch::Matchers::WithinRel(0.4, 1e-14));
+    REQUIRE_THAT(normalized[1].to(), Catch::Matchers::WithinRel(0.2, 1e-14));
+
+    // Works beyond the range of double.
+    LogValHistogram<double> big(2, LogVal<double>::from_log(5000.0));
+    big.multiply(1, LogVal(0.9));
+    REQUIRE(big.is_flat(0.8));
+    REQUIRE_FALSE(big.is_flat(0.99));
+    REQUIRE_THAT(big.normalized(LogVal(1.9))[0].to(),
+                 Catch::Matchers::WithinRel(1.0, 1e-14));
+
+    LogValHistogram<float> floats(2, LogVal(1.0F));
+    floats.add(0, LogVal(1.0F));
+    REQUIRE_THAT(floats[0].to(), Catch::Matchers::WithinRel(2.0F, 1e-6F));
+}
+
+TEST_CASE("Histogram concurrent updates", "[histogram]") {
+    constexpr int threads = 8;
+    constexpr int updates = 20000;
+
+    LogValHistogram<double> hist(3);
+    hist.set(1, LogVal(1.0));
+    {
+        std::vector<std::jthread> pool;
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back([&hist]() {
+                for (int i = 0; i < updates; ++i) {
+                    hist.add(0, LogVal(1.0));
+                    hist.multiply(1, LogVal<double>::from_log(0.001));
+                    hist.add(2, LogVal(i % 2 == 0 ? 1.0 : -1.0));
+                }
+            });
+        }
+    }
+
+    REQUIRE_THAT(hist[0].to(),
+                 Catch::Matchers::WithinRel(threads * updates, 1e-10));
+    REQUIRE_THAT(hist[1].log_abs(),
+                 Catch::Matchers::WithinRel(0.001 * threads * updates, 1e-10));
+    REQUIRE_THAT(hist[2].to(), Catch::Matchers::WithinAbs(0.0, 1e-8));
+}
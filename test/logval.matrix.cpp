@@ -0,0 +1,182 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/Matrix.hpp>
+#include <LogValCpp/Parallel.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+auto make_matrix(std::size_t rows, std::size_t cols, double offset)
+    -> std::vector<double> {
+    std::vector<double> res(rows * cols);
+    for (std::size_t i = 0; i < res.size(); ++i) {
+        res[i] = (i % 7 == 3) ? 0.0 : std::sin(offset + static_cast<double>(i));
+    }
+    return res;
+}
+
+auto to_logvals(const std::vector<double> &values)
+    -> std::vector<LogVal<double>> {
+    return {values.begin(), values.end()};
+}
+
+}  // namespace
+
+TEST_CASE("Matrix product", "[matrix]") {
+    // sizes around the block sizes and the number of register rows
+    auto dims = GENERATE(std::array<std::size_t, 3>{1, 1, 1},
+                         std::array<std::size_t, 3>{5, 3, 7},
+                         std::array<std::size_t, 3>{67, 300, 9},
+                         std::array<std::size_t, 3>{130, 20, 260});
+    auto layout = GENERATE(logval::Layout::row_major,
+                           logval::Layout::column_major);
+    const auto [m, k, n] = dims;
+
+    // Values are stored in `layout`, the reference works on the same storage.
+    const auto a = make_matrix(m, k, 0.0);
+    const auto b = make_matrix(k, n, 1.0);
+    auto at = [&](const std::vector<double> &mat, std::size_t rows,
+                  std::size_t cols, std::size_t i, std::size_t j) {
+        return layout == logval::Layout::row_major ? mat[i * cols + j]
+                                                   : mat[j * rows + i];
+    };
+
+    auto a_log = to_logvals(a);
+    auto b_log = to_logvals(b);
+    std::vector<LogVal<double>> c_log(m * n, LogVal(1.0));
+    logval::gemm(logval::MatrixView(a_log.data(), m, k, layout),
+                 logval::MatrixView(b_log.data(), k, n, layout),
+                 logval::MatrixView(c_log.data(), m, n, layout));
+
+    std::vector<LogVal<double>> c_par(m * n, LogVal(0.0));
+    logval::par::gemm(logval::MatrixView(a_log.data(), m, k, layout),
+                      logval::MatrixView(b_log.data(), k, n, layout),
+                      logval::MatrixView(c_par.data(), m, n, layout),
+                      {.threads = 3});
+
+    const logval::MatrixView c_view(c_log.data(), m, n, layout);
+    const logval::MatrixView c_par_view(c_par.data(), m, n, layout);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            double expected = 0.0;
+            for (std::size_t l = 0; l < k; ++l) {
+                expected += at(a, m, k, i, l) * at(b, k, n, l, j);
+            }
+            REQUIRE_THAT(c_view(i, j).to(),
+                         Catch::Matchers::WithinAbs(expected, 1e-12));
+            REQUIRE(c_par_view(i, j) == c_view(i, j));
+        }
+    }
+}
+
+TEST_CASE("Matrix product beyond the range of double", "[matrix]") {
+    // A = exp(600) [[1, 2], [3, 4]], B = exp(500) [[-1, 0], [1, 2]]
+    const auto sa = LogVal<double>::from_log(600.0);
+    const auto sb = LogVal<double>::from_log(500.0);
+    const std::vector<LogVal<double>> a{LogVal(1.0) * sa, LogVal(2.0) * sa,
+                                        LogVal(3.0) * sa, LogVal(4.0) * sa};
+    const std::vector<LogVal<double>> b{LogVal(-1.0) * sb, LogVal(0.0),
+                                        LogVal(1.0) * sb, LogVal(2.0) * sb};
+    std::vector<LogVal<double>> c(4, LogVal(0.0));
+
+    logval::gemm(logval::MatrixView(a.data(), 2, 2),
+                 logval::MatrixView(b.data(), 2, 2),
+                 logval::MatrixView(c.data(), 2, 2));
+
+    const std::vector<double> expected{1.0, 4.0, 1.0, 8.0};
+    for (std::size_t i = 0; i < 4; ++i) {
+        REQUIRE(c[i].sign() == LogVal<double>::Sign::positive);
+        REQUIRE_THAT(c[i].log_abs(),
+                     Catch::Matchers::WithinRel(
+                         1100.0 + std::log(expected[i]), 1e-12));
+    }
+}
+
+TEST_CASE("Matrix product with a wide dynamic range", "[matrix]") {
+    using Sign = LogVal<double>::Sign;
+
+    // Ising transfer matrix with beta J = 400, the off-diagonal elements of
+    // its square are two terms of exp(0) next to diagonal ones of exp(800).
+    const auto large = LogVal<double>::from_log(400.0);
+    const auto small = LogVal<double>::from_log(-400.0);
+    const std::vector<LogVal<double>> transfer{large, small, small, large};
+    std::vector<LogVal<double>> square(4, LogVal(0.0));
+    logval::gemm(logval::MatrixView(transfer.data(), 2, 2),
+                 logval::MatrixView(transfer.data(), 2, 2),
+                 logval::MatrixView(square.data(), 2, 2));
+    REQUIRE_THAT(square[0].log_abs(), Catch::Matchers::WithinRel(800.0));
+    REQUIRE_THAT(square[1].to(), Catch::Matchers::WithinRel(2.0, 1e-15));
+    REQUIRE_THAT(square[2].to(), Catch::Matchers::WithinRel(2.0, 1e-15));
+
+    // Logarithms spread over [-1000, 1000], compared with operator+=.
+    const std::size_t m = 70;
+    const std::size_t k = 300;
+    const std::size_t n = 20;
+    auto make = [](std::size_t rows, std::size_t cols, double offset) {
+        std::vector<LogVal<double>> res;
+        for (std::size_t i = 0; i < rows * cols; ++i) {
+            const double x = offset + static_cast<double>(i);
+            res.push_back(i % 11 == 5 ? LogVal(0.0)
+                                      : LogVal<double>::from_log(
+                                            1000.0 * std::sin(x * x)));
+        }
+        return res;
+    };
+    const auto a = make(m, k, 0.0);
+    const auto b = make(k, n, 0.5);
+    std::vector<LogVal<double>> c(m * n, LogVal(1.0));
+    logval::gemm(logval::MatrixView(a.data(), m, k),
+                 logval::MatrixView(b.data(), k, n),
+                 logval::MatrixView(c.data(), m, n));
+    std::vector<LogVal<double>> c_par(m * n, LogVal(1.0));
+    logval::par::gemm(logval::MatrixView(a.data(), m, k),
+                      logval::MatrixView(b.data(), k, n),
+                      logval::MatrixView(c_par.data(), m, n), {.threads = 2});
+
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            LogVal<double> expected(0.0);
+            for (std::size_t l = 0; l < k; ++l) {
+                expected += a[i * k + l] * b[l * n + j];
+            }
+            const auto res = c[i * n + j];
+            REQUIRE(res.sign() == expected.sign());
+            if (expected.sign() != Sign::null) {
+                REQUIRE_THAT(res.log_abs(),
+                             Catch::Matchers::WithinAbs(expected.log_abs(),
+                                                        1e-9));
+            }
+            REQUIRE(c_par[i * n + j] == res);
+        }
+    }
+}
+
+TEST_CASE("Matrix vector product", "[matrix]") {
+    auto layout = GENERATE(logval::Layout::row_major,
+                           logval::Layout::column_major);
+    const std::size_t m = 13;
+    const std::size_t n = 2100;
+
+    const auto a = make_matrix(m, n, 0.0);
+    const auto x = make_matrix(n, 1, 2.0);
+    const auto a_log = to_logvals(a);
+    const auto x_log = to_logvals(x);
+    std::vector<LogVal<double>> y(m, LogVal(0.0));
+
+    logval::gemv(logval::MatrixView(a_log.data(), m, n, layout), x_log.data(),
+                 y.data());
+
+    for (std::size_t i = 0; i < m; ++i) {
+        double expected = 0.0;
+        for (std::size_t j = 0; j < n; ++j) {
+            expected += (layout == logval::Layout::row_major ? a[i * n + j]
+                                                             : a[j * m + i]) *
+                        x[j];
+        }
+        REQUIRE_THAT(y[i].to(), Catch::Matchers::WithinAbs(expected, 1e-10));
+    }
+}
@@ -1,89 +1,95 @@
 #include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/PackedLogVal.hpp>
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <iostream>
 #include <utility>
 
-TEST_CASE("Assignment multiplication with 1.0", "[multiplication]") {
+TEMPLATE_TEST_CASE("Assignment multiplication with 1.0", "[multiplication]",
+                   LogVal<double>, PackedLogVal<double>) {
     SECTION("1.0 *= 1.0") {
-        LogVal val1(1.0);
-        val1 *= LogVal(1.0);
-        REQUIRE(val1 == LogVal(1.0));
+        TestType val1(1.0);
+        val1 *= TestType(1.0);
+        REQUIRE(val1 == TestType(1.0));
 
         val1 *= val1;
-        REQUIRE(val1 == LogVal(1.0));
+        REQUIRE(val1 == TestType(1.0));
 
-        const LogVal val2(1.0);
+        const TestType val2(1.0);
         val1 *= val2;
-        REQUIRE(val1 == LogVal(1.0));
+        REQUIRE(val1 == TestType(1.0));
     }
 
     SECTION("1.0 *= -1.0") {
-        LogVal val1(1.0);
-        val1 *= LogVal(-1.0);
-        REQUIRE(val1 == LogVal(-1.0));
+        TestType val1(1.0);
+        val1 *= TestType(-1.0);
+        REQUIRE(val1 == TestType(-1.0));
 
-        const LogVal val2(-1.0);
-        val1 = LogVal(1.0);
+        const TestType val2(-1.0);
+        val1 = TestType(1.0);
         val1 *= val2;
-        REQUIRE(val1 == LogVal(-1.0));
+        REQUIRE(val1 == TestType(-1.0));
     }
 }
 
-TEST_CASE("Assignment multiplication", "[multiplication]") {
+TEMPLATE_TEST_CASE("Assignment multiplication", "[multiplication]",
+                   LogVal<double>, PackedLogVal<double>) {
     auto lhs = GENERATE(0.01, 2.0, -2.0, 3456.0, 3.45e7);
     auto rhs = GENERATE(0.003, 2.0, -2.0, -42.0, -2.01e9);
 
-    LogVal val1(lhs);
-    val1 *= LogVal(rhs);
+    TestType val1(lhs);
+    val1 *= TestType(rhs);
     REQUIRE_THAT(val1.to(), Catch::Matchers::WithinRel(lhs * rhs));
 }
 
-TEST_CASE("Multiplication with 1.0", "[multiplication]") {
+TEMPLATE_TEST_CASE("Multiplication with 1.0", "[multiplication]",
+                   LogVal<double>, PackedLogVal<double>) {
     SECTION("1.0 * 1.0") {
-        REQUIRE(LogVal(1.0) * LogVal(1.0) == LogVal(1.0));
+        REQUIRE(TestType(1.0) * TestType(1.0) == TestType(1.0));
 
-        const LogVal val1(1.0);
-        REQUIRE(val1 * LogVal(1.0) == LogVal(1.0));
+        const TestType val1(1.0);
+        REQUIRE(val1 * TestType(1.0) == TestType(1.0));
 
-        const LogVal val2(1.0);
-        REQUIRE(val1 * val2 == LogVal(1.0));
+        const TestType val2(1.0);
+        REQUIRE(val1 * val2 == TestType(1.0));
     }
 
     SECTION("1.0 * -1.0") {
-        REQUIRE(LogVal(1.0) * LogVal(-1.0) == LogVal(-1.0));
+        REQUIRE(TestType(1.0) * TestType(-1.0) == TestType(-1.0));
 
-        const LogVal val1(1.0);
-        REQUIRE(val1 * LogVal(-1.0) == LogVal(-1.0));
+        const TestType val1(1.0);
+        REQUIRE(val1 * TestType(-1.0) == TestType(-1.0));
 
-        const LogVal val2(-1.0);
-        REQUIRE(val2 * LogVal(1.0) == LogVal(-1.0));
+        const TestType val2(-1.0);
+        REQUIRE(val2 * TestType(1.0) == TestType(-1.0));
 
-        const LogVal val3(-1.0);
-        REQUIRE(val1 * val3 == LogVal(-1.0));
+        const TestType val3(-1.0);
+        REQUIRE(val1 * val3 == TestType(-1.0));
     }
 
     SECTION("-1.0 * -1.0") {
-        REQUIRE(LogVal(-1.0) * LogVal(-1.0) == LogVal(1.0));
+        REQUIRE(TestType(-1.0) * TestType(-1.0) == TestType(1.0));
 
-        const LogVal val1(-1.0);
-        REQUIRE(val1 * LogVal(-1.0) == LogVal(1.0));
+        const TestType val1(-1.0);
+        REQUIRE(val1 * TestType(-1.0) == TestType(1.0));
 
-        const LogVal val2(-1.0);
-        REQUIRE(val1 * val2 == LogVal(1.0));
+        const TestType val2(-1.0);
+        REQUIRE(val1 * val2 == TestType(1.0));
     }
 }
 
-TEST_CASE("Multiplication", "[multiplication]") {
+TEMPLATE_TEST_CASE("Multiplication", "[multiplication]",
+                   LogVal<double>, PackedLogVal<double>) {
     auto lhs = GENERATE(0.0, 0.01, 2.0, -2.0, 3456.0, 3.45e7);
     auto rhs = GENERATE(0.0, 0.003, 2.0, -2.0, -42.0, -2.01e9);
 
-    REQUIRE_THAT((LogVal(lhs) * LogVal(rhs)).to(),
+    REQUIRE_THAT((TestType(lhs) * TestType(rhs)).to(),
                  Catch::Matchers::WithinRel(lhs * rhs));
 
-    const LogVal val1(lhs);
-    const LogVal val2(rhs);
+    const TestType val1(lhs);
+    const TestType val2(rhs);
 
     REQUIRE_THAT((val1 * val2).to(), Catch::Matchers::WithinRel(lhs * rhs));
 }
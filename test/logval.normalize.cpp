@@ -0,0 +1,110 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <LogValCpp/Normalize.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+TEST_CASE("Log partition", "[normalize]") {
+    std::vector<LogVal<double>> weights{LogVal(1.0), LogVal(0.0), LogVal(3.0)};
+    REQUIRE_THAT(logval::log_partition(std::span(weights)),
+                 Catch::Matchers::WithinRel(std::log(4.0), 1e-15));
+    const std::vector<LogVal<double>> empty;
+    REQUIRE(logval::log_partition(std::span(empty)) ==
+            -std::numeric_limits<double>::infinity());
+
+    // Base two policy, the result is to the base of the policy.
+    std::vector<LogVal<double, Base2>> base2{LogVal<double, Base2>(2.0),
+                                             LogVal<double, Base2>(6.0)};
+    REQUIRE_THAT(logval::log_partition(std::span(base2)),
+                 Catch::Matchers::WithinRel(3.0, 1e-15));
+}
+
+TEST_CASE("Normalize in place", "[normalize]") {
+    const auto size = GENERATE(std::size_t{1}, std::size_t{7},
+                               std::size_t{5000});
+    std::vector<LogVal<double>> weights;
+    for (std::size_t i = 0; i < size; ++i) {
+        // Far beyond the range of double, zeros in between.
+        weights.push_back(i % 5 == 4 ? LogVal(0.0)
+                                     : LogVal<double>::from_log(
+                                           1e4 + std::sin(i * 0.3) * 30.0));
+    }
+    const auto expected = logval::sum(std::span(weights));
+
+    const auto total = logval::normalize(std::span(weights));
+    REQUIRE(total == expected);
+    REQUIRE_THAT(logval::sum(std::span(weights)).to(),
+                 Catch::Matchers::WithinRel(1.0, 1e-12));
+    REQUIRE(weights.back().sign() != LogVal<double>::Sign::negative);
+
+    // A zero sum leaves the values unchanged.
+    std::vector<LogVal<double>> cancelling{LogVal(2.0), LogVal(-2.0)};
+    REQUIRE(logval::normalize(std::span(cancelling)).sign() ==
+            LogVal<double>::Sign::null);
+    REQUIRE(cancelling[0].to() == 2.0);
+}
+
+TEST_CASE("Probabilities", "[normalize]") {
+    const auto size = GENERATE(std::size_t{1}, std::size_t{100},
+                               std::size_t{3000});
+    std::vector<LogVal<double>> weights;
+    for (std::size_t i = 0; i < size; ++i) {
+        weights.push_back(i % 7 == 3 ? LogVal(0.0)
+                                     : LogVal<double>::from_log(
+                                           -800.0 + std::cos(i * 0.7) * 50.0));
+    }
+
+    std::vector<double> probabilities(size, -1.0);
+    const auto total =
+        logval::to_probabilities(std::span(weights), std::span(probabilities));
+    REQUIRE(total == logval::sum(std::span(weights)));
+    REQUIRE_THAT(std::accumulate(probabilities.begin(), probabilities.end(),
+                                 0.0),
+                 Catch::Matchers::WithinRel(1.0, 1e-12));
+    for (std::size_t i = 0; i < size; ++i) {
+        INFO(i);
+        REQUIRE_THAT(probabilities[i],
+                     Catch::Matchers::WithinRel((weights[i] / total).to(),
+                                                1e-12) ||
+                         Catch::Matchers::WithinAbs(0.0, 1e-300));
+    }
+}
+
+TEST_CASE("Probabilities of mixed signs", "[normalize]") {
+    // Signed weights: -1, 0, 4, -1 sum to 2.
+    const std::vector<LogVal<double>> weights{LogVal(-1.0), LogVal(0.0),
+                                              LogVal(4.0), LogVal(-1.0)};
+    std::vector<double> probabilities(weights.size());
+    logval::to_probabilities(std::span(weights), std::span(probabilities));
+    REQUIRE_THAT(probabilities[0], Catch::Matchers::WithinRel(-0.5, 1e-15));
+    REQUIRE(probabilities[1] == 0.0);
+    REQUIRE_THAT(probabilities[2], Catch::Matchers::WithinRel(2.0, 1e-15));
+
+    // Negative sum: -3, 1 sum to -2.
+    const std::vector<LogVal<double>> negative{LogVal(-3.0), LogVal(1.0)};
+    logval::to_probabilities(std::span(negative),
+                             std::span(probabilities).first(2));
+    REQUIRE_THAT(probabilities[0], Catch::Matchers::WithinRel(1.5, 1e-15));
+    REQUIRE_THAT(probabilities[1], Catch::Matchers::WithinRel(-0.5, 1e-15));
+
+    // Zero sum.
+    const std::vector<LogVal<double>> cancelling{LogVal(2.0), LogVal(-2.0)};
+    logval::to_probabilities(std::span(cancelling),
+                             std::span(probabilities).first(2));
+    REQUIRE(std::isnan(probabilities[0]));
+
+    // float weights.
+    std::vector<LogVal<float>> floats{LogVal(1.0F), LogVal(3.0F)};
+    std::vector<float> float_probabilities(2);
+    logval::to_probabilities(std::span(floats),
+                             std::span(float_probabilities));
+    REQUIRE_THAT(float_probabilities[1],
+                 Catch::Matchers::WithinRel(0.75F, 1e-6F));
+}
@@ -0,0 +1,142 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/PackedLogVal.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <atomic>
+#include <bit>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("Packed layout", "[packed]") {
+    STATIC_REQUIRE(sizeof(PackedLogVal<double>) == sizeof(double));
+    STATIC_REQUIRE(sizeof(PackedLogVal<float>) == sizeof(float));
+    STATIC_REQUIRE(std::is_trivially_copyable_v<PackedLogVal<double>>);
+    STATIC_REQUIRE(std::atomic<PackedLogVal<double>>::is_always_lock_free);
+}
+
+TEST_CASE("Packed conversion", "[packed]") {
+    auto val = GENERATE(-3.5e11, -2.0, -1.0, 0.0, -0.0, 0.01, 1.0, 3456.0,
+                        1e300);
+
+    const PackedLogVal packed(val);
+    REQUIRE_THAT(packed.to(), Catch::Matchers::WithinRel(val, 1e-12));
+    REQUIRE(packed.sign() == LogVal(val).sign());
+    REQUIRE_THAT(packed.log_abs(),
+                 Catch::Matchers::WithinULP(LogVal(val).log_abs(), 1));
+
+    REQUIRE(PackedLogVal(1.0).to() == 1.0);
+    REQUIRE(PackedLogVal(-1.0).to() == -1.0);
+    REQUIRE(PackedLogVal(0.0).to() == 0.0);
+
+    REQUIRE(PackedLogVal<double>::from_bits(packed.bits()) == packed);
+    REQUIRE(PackedLogVal(packed.unpack()) == packed);
+    REQUIRE(PackedLogVal<double>::from_log(1.0, LogVal<double>::Sign::null) ==
+            PackedLogVal(0.0));
+    REQUIRE(PackedLogVal<double>::from_log(0.0,
+                                           LogVal<double>::Sign::negative) ==
+            PackedLogVal(-1.0));
+}
+
+TEST_CASE("Packed arithmetic", "[packed]") {
+    auto lhs = GENERATE(-20000.0, -2.0, 0.0, 1.0, 3.0, 42.0, 3.46e9);
+    auto rhs = GENERATE(-4.46e9, -3.0, -1.0, 0.0, 1.0, 4.0, 23112.3);
+
+    const PackedLogVal a(lhs);
+    const PackedLogVal b(rhs);
+    constexpr double eps = 1e-9;
+
+    REQUIRE_THAT((a + b).to(),
+                 Catch::Matchers::WithinRel(lhs + rhs, eps) ||
+                     Catch::Matchers::WithinAbs(lhs + rhs, eps));
+    REQUIRE_THAT((a - b).to(),
+                 Catch::Matchers::WithinRel(lhs - rhs, eps) ||
+                     Catch::Matchers::WithinAbs(lhs - rhs, eps));
+    REQUIRE_THAT((a * b).to(), Catch::Matchers::WithinRel(lhs * rhs, eps));
+    if (rhs != 0.0) {
+        REQUIRE_THAT((a / b).to(), Catch::Matchers::WithinRel(lhs / rhs, eps));
+    }
+
+    PackedLogVal tmp = a;
+    tmp += b;
+    REQUIRE(tmp == a + b);
+    tmp -= b;
+    tmp *= b;
+    REQUIRE(tmp == (a + b - b) * b);
+
+    REQUIRE((a - a).sign() == LogVal<double>::Sign::null);
+}
+
+TEST_CASE("Packed comparison and unary operators", "[packed]") {
+    auto lhs = GENERATE(-5.0, -2.0, -1.0, 0.0, 1.0, 3.0);
+    auto rhs = GENERATE(-2.0, 0.0, 1.0, 1e300);
+
+    REQUIRE((PackedLogVal(lhs) < PackedLogVal(rhs)) == (lhs < rhs));
+    REQUIRE((PackedLogVal(lhs) <= PackedLogVal(rhs)) == (lhs <= rhs));
+    REQUIRE((PackedLogVal(lhs) == PackedLogVal(rhs)) == (lhs == rhs));
+    REQUIRE((PackedLogVal(lhs).order_key() < PackedLogVal(rhs).order_key()) ==
+            (lhs < rhs));
+
+    PackedLogVal val(lhs);
+    REQUIRE((-val).to() == -val.to());
+    REQUIRE((+val) == val);
+    val.negate();
+    REQUIRE(val == PackedLogVal(-1.0 * lhs));
+}
+
+TEST_CASE("Packed values beyond the range of double", "[packed]") {
+    const auto huge = PackedLogVal<double>::from_log(
+        1e6, LogVal<double>::Sign::negative);
+
+    REQUIRE((huge * huge).log_abs() == 2e6);
+    REQUIRE((huge * huge).sign() == LogVal<double>::Sign::positive);
+    REQUIRE(huge < PackedLogVal(-1e300));
+    REQUIRE((huge - huge).to() == 0.0);
+}
+
+TEST_CASE("Packed rounding", "[packed]") {
+    using Sign = LogVal<double>::Sign;
+
+    // Consecutive logarithms, half of them have an odd mantissa. Rounding
+    // half to even moves as many of them up as down.
+    double log_val = 1.0;
+    double drift = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+        const double packed = PackedLogVal<double>::from_log(log_val).log_abs();
+        REQUIRE_THAT(packed, Catch::Matchers::WithinULP(log_val, 1));
+        drift += packed - log_val;
+        log_val = std::nextafter(log_val, 2.0);
+    }
+    REQUIRE(std::abs(drift) <= 2.0 * std::numeric_limits<double>::epsilon());
+
+    // Largest finite logarithms do not round to infinity.
+    const double max = std::numeric_limits<double>::max();
+    REQUIRE(std::isfinite(PackedLogVal<double>::from_log(max).log_abs()));
+
+    // Negative infinity has no bit pattern of its own.
+    const auto inf = std::numeric_limits<double>::infinity();
+    const PackedLogVal<double> negative_inf(-inf);
+    REQUIRE(!std::isnan(std::bit_cast<double>(negative_inf.bits())));
+    REQUIRE(negative_inf.sign() == Sign::negative);
+    REQUIRE(std::isfinite(negative_inf.log_abs()));
+    REQUIRE(negative_inf.to() == -inf);
+    REQUIRE(negative_inf <
+            PackedLogVal<double>::from_log(1e308, Sign::negative));
+    REQUIRE(PackedLogVal<double>(inf).log_abs() == inf);
+}
+
+TEST_CASE("Packed sum", "[packed]") {
+    std::vector<PackedLogVal<double>> values;
+    double expected = 0.0;
+    for (int i = 0; i < 2000; ++i) {
+        const double val = std::sin(static_cast<double>(i)) * 10.0;
+        values.emplace_back(val);
+        expected += val;
+    }
+
+    REQUIRE_THAT(logval::sum(values.begin(), values.end()).to(),
+                 Catch::Matchers::WithinRel(expected, 1e-10));
+}
@@ -0,0 +1,115 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <LogValCpp/Parallel.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+auto mixed_values(int size) -> std::vector<LogVal<double>> {
+    std::vector<LogVal<double>> vec;
+    for (int i = 0; i < size; ++i) {
+        const double val =
+            (i % 5 == 0) ? 0.0 : (i % 2 == 0 ? 1.5 : -1.0) * (1 + i % 17);
+        vec.emplace_back(val);
+    }
+    return vec;
+}
+
+}  // namespace
+
+TEST_CASE("Parallel sum of empty range", "[parallel]") {
+    const std::vector<LogVal<double>> vec;
+
+    REQUIRE(logval::par::sum(vec.begin(), vec.end()) == LogVal(0.0));
+    REQUIRE(logval::par::product(vec.begin(), vec.end()) == LogVal(1.0));
+    REQUIRE(logval::par::dot(vec.begin(), vec.end(), vec.begin()) ==
+            LogVal(0.0));
+    REQUIRE(logval::par::sum(LogValArray<double>()) == LogVal(0.0));
+}
+
+TEST_CASE("Parallel sum", "[parallel]") {
+    auto size = GENERATE(1, 1000, 100000);
+    auto threads = GENERATE(1U, 2U, 3U, 8U);
+
+    const auto vec = mixed_values(size);
+    const auto expected = logval::sum(vec.begin(), vec.end());
+
+    const logval::par::Options options{.threads = threads};
+    REQUIRE_THAT(logval::par::sum(vec.begin(), vec.end(), options).to(),
+                 Catch::Matchers::WithinRel(expected.to(), 1e-12));
+
+    const LogValArray<double> arr(vec.begin(), vec.end());
+    REQUIRE_THAT(logval::par::sum(arr, options).to(),
+                 Catch::Matchers::WithinRel(expected.to(), 1e-12));
+}
+
+TEST_CASE("Parallel product", "[parallel]") {
+    auto threads = GENERATE(1U, 2U, 5U);
+    const logval::par::Options options{.threads = threads};
+
+    std::vector<LogVal<double>> vec;
+    double expected_log = 0.0;
+    for (int i = 0; i < 3001; ++i) {
+        vec.emplace_back(i % 2 == 0 ? 1.5 : -2.0);
+        expected_log += i % 2 == 0 ? std::log(1.5) : std::log(2.0);
+    }
+
+    // 1500 negative factors
+    const auto res = logval::par::product(vec.begin(), vec.end(), options);
+    REQUIRE(res.sign() == LogVal<double>::Sign::positive);
+    REQUIRE_THAT(res.log_abs(),
+                 Catch::Matchers::WithinRel(expected_log, 1e-12));
+
+    vec.emplace_back(-3.0);
+    REQUIRE(logval::par::product(vec.begin(), vec.end(), options).sign() ==
+            LogVal<double>::Sign::negative);
+
+    vec[1234] = LogVal(0.0);
+    REQUIRE(logval::par::product(vec.begin(), vec.end(), options) ==
+            LogVal(0.0));
+}
+
+TEST_CASE("Parallel dot product", "[parallel]") {
+    auto threads = GENERATE(1U, 2U, 7U);
+    const logval::par::Options options{.threads = threads};
+
+    const auto lhs = mixed_values(20000);
+    std::vector<LogVal<double>> rhs;
+    double expected = 0.0;
+    for (int i = 0; i < 20000; ++i) {
+        rhs.emplace_back(i % 3 == 0 ? -0.5 : 2.0);
+        expected += lhs[i].to() * rhs.back().to();
+    }
+
+    REQUIRE_THAT(
+        logval::par::dot(lhs.begin(), lhs.end(), rhs.begin(), options).to(),
+        Catch::Matchers::WithinRel(expected, 1e-12));
+}
+
+TEST_CASE("Deterministic parallel reductions", "[parallel]") {
+    const auto vec = mixed_values(200000);
+    const LogValArray<double> arr(vec.begin(), vec.end());
+
+    const logval::par::Options reference{
+        .threads = 1, .deterministic = true, .chunk_size = 1000};
+    const auto sum = logval::par::sum(vec.begin(), vec.end(), reference);
+    const auto sum_arr = logval::par::sum(arr, reference);
+    const auto dot =
+        logval::par::dot(vec.begin(), vec.end(), vec.begin(), reference);
+
+    auto threads = GENERATE(2U, 3U, 8U, 13U);
+    const logval::par::Options options{
+        .threads = threads, .deterministic = true, .chunk_size = 1000};
+
+    // identical bit for bit
+    REQUIRE(logval::par::sum(vec.begin(), vec.end(), options).log_abs() ==
+            sum.log_abs());
+    REQUIRE(logval::par::sum(arr, options).log_abs() == sum_arr.log_abs());
+    REQUIRE(logval::par::dot(vec.begin(), vec.end(), vec.begin(), options)
+                .log_abs() == dot.log_abs());
+}
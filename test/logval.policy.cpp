@@ -0,0 +1,92 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/MathPolicy.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace {
+
+// Maximal absolute error of `Policy::add(0, -d)` and `Policy::subtract(0, -d)`
+// compared to a long double reference, for `d` in [`min_diff`, `max_diff`].
+template <typename Policy, typename T>
+auto max_kernel_error(T min_diff, T max_diff, bool subtract) -> long double {
+    constexpr int steps = 200000;
+
+    long double max_error = 0.0L;
+    for (int i = 0; i <= steps; ++i) {
+        const T diff = min_diff + (max_diff - min_diff) * static_cast<T>(i) /
+                                      static_cast<T>(steps);
+        const long double ldiff = static_cast<long double>(diff);
+        const long double expected = subtract
+                                         ? std::log(-std::expm1(-ldiff))
+                                         : std::log1p(std::exp(-ldiff));
+        const T res = subtract ? Policy::subtract(T(0), -diff)
+                               : Policy::add(T(0), -diff);
+        max_error = std::max(max_error,
+                             std::abs(static_cast<long double>(res) - expected));
+    }
+    return max_error;
+}
+
+}  // namespace
+
+TEST_CASE("ExactMath error bound", "[policy]") {
+    constexpr long double eps = std::numeric_limits<double>::epsilon();
+
+    REQUIRE(max_kernel_error<ExactMath>(0.0, 50.0, false) <= 4 * eps);
+    REQUIRE(max_kernel_error<ExactMath>(std::numbers::ln2, 50.0, true) <=
+            4 * eps);
+}
+
+TEST_CASE("FastMath error bound", "[policy]") {
+    constexpr long double eps = std::numeric_limits<double>::epsilon();
+    constexpr long double eps_float = std::numeric_limits<float>::epsilon();
+
+    REQUIRE(max_kernel_error<FastMath<4>>(0.0, 50.0, false) <= 4 * eps);
+    REQUIRE(max_kernel_error<FastMath<4>>(std::numbers::ln2, 50.0, true) <=
+            4 * eps);
+    // closer operands use log(-expm1(-d))
+    REQUIRE(max_kernel_error<FastMath<4>>(1e-6, std::numbers::ln2, true) <=
+            4 * eps);
+
+    REQUIRE(max_kernel_error<FastMath<16>>(0.0, 50.0, false) <= 16 * eps);
+    REQUIRE(max_kernel_error<FastMath<1024>>(0.0, 50.0, false) <= 1024 * eps);
+    REQUIRE(max_kernel_error<FastMath<1024>>(std::numbers::ln2, 50.0, true) <=
+            1024 * eps);
+
+    REQUIRE(max_kernel_error<FastMath<1U << 20U>>(0.0, 50.0, false) <=
+            (1U << 20U) * eps);
+
+    REQUIRE(max_kernel_error<FastMath<4>>(0.0F, 30.0F, false) <=
+            4 * eps_float);
+    REQUIRE(max_kernel_error<FastMath<4>>(std::numbers::ln2_v<float>, 30.0F,
+                                          true) <= 4 * eps_float);
+}
+
+TEST_CASE("FastMath returns the larger operand beyond the cutoff",
+          "[policy]") {
+    REQUIRE(FastMath<4>::add(1.0, -40.0) == 1.0);
+    REQUIRE(FastMath<4>::subtract(1.0, -40.0) == 1.0);
+    REQUIRE(FastMath<1U << 20U>::add(3.0, -20.0) == 3.0);
+}
+
+TEST_CASE("Addition with FastMath policy", "[policy][add]") {
+    using FastLogVal = LogVal<double, FastMath<4>>;
+
+    auto lhs = GENERATE(1.0, -20000.0, 3.46e9, 0.0);
+    auto rhs = GENERATE(-1.0, 23112.3, -4.46e9, -2.34e7, 0.0);
+
+    REQUIRE_THAT((FastLogVal(lhs) + FastLogVal(rhs)).to(),
+                 Catch::Matchers::WithinRel(lhs + rhs));
+    REQUIRE_THAT((FastLogVal(lhs) - FastLogVal(rhs)).to(),
+                 Catch::Matchers::WithinRel(lhs - rhs));
+    REQUIRE_THAT((FastLogVal(lhs) * FastLogVal(rhs)).to(),
+                 Catch::Matchers::WithinRel(lhs * rhs));
+
+    // Conversion between policies keeps the value.
+    const LogVal<double> exact(FastLogVal(lhs) + FastLogVal(rhs));
+    REQUIRE(exact == LogVal(lhs) + LogVal(rhs));
+}
@@ -0,0 +1,105 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <LogValCpp/Sort.hpp>
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cmath>
+#include <compare>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+auto random_logvals(std::size_t count) -> std::vector<LogVal<double>> {
+    std::mt19937 gen(42);
+    std::normal_distribution<double> logs(0.0, 1000.0);
+    std::uniform_int_distribution<int> signs(-1, 1);
+
+    std::vector<LogVal<double>> vec;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto val = LogVal<double>::from_log(logs(gen));
+        const int sign = signs(gen);
+        if (sign < 0) {
+            val.negate();
+        } else if (sign == 0) {
+            val *= LogVal(0.0);
+        }
+        vec.push_back(val);
+    }
+    return vec;
+}
+
+}  // namespace
+
+TEST_CASE("Comparison beyond the range of double", "[comparision]") {
+    const auto huge = LogVal<double>::from_log(1000.0);
+    const auto larger = LogVal<double>::from_log(1001.0);
+    const auto tiny = LogVal<double>::from_log(-1000.0);
+
+    REQUIRE(huge < larger);
+    REQUIRE(-larger < -huge);
+    REQUIRE(tiny > LogVal(0.0));
+    REQUIRE(-tiny < LogVal(0.0));
+    REQUIRE(tiny < huge);
+    REQUIRE(-huge < tiny);
+    REQUIRE(std::is_eq(huge <=> LogVal<double>::from_log(1000.0)));
+}
+
+TEST_CASE("Order key is monotone", "[sort]") {
+    using pair = std::pair<double, double>;
+    auto [lhs, rhs] = GENERATE(table<double, double>(
+        {pair{-5.0, -2.0}, pair{-2.0, 0.0}, pair{-1.0, 1.0}, pair{0.0, 1.0},
+         pair{1.0, 3.0}, pair{1e-300, 1e300}, pair{-1e300, -1e-300}}));
+
+    REQUIRE(LogVal(lhs).order_key() < LogVal(rhs).order_key());
+    REQUIRE(LogVal<float>(static_cast<float>(lhs)).order_key() <=
+            LogVal<float>(static_cast<float>(rhs)).order_key());
+    REQUIRE(LogVal(lhs).order_key() == LogVal(lhs).order_key());
+    REQUIRE(LogVal(0.0).order_key() == LogVal(-0.0).order_key());
+
+    const auto inf = std::numeric_limits<double>::infinity();
+    REQUIRE(LogVal<double>::from_log(inf).order_key() >
+            LogVal(rhs).order_key());
+    REQUIRE((-LogVal<double>::from_log(inf)).order_key() <
+            LogVal(lhs).order_key());
+}
+
+TEST_CASE("Radix sort", "[sort]") {
+    auto vec = random_logvals(10000);
+    // values whose logarithms differ only in the last bit
+    vec.push_back(LogVal<double>::from_log(std::nextafter(1.0, 2.0)));
+    vec.push_back(LogVal<double>::from_log(1.0));
+
+    auto expected = vec;
+    std::sort(expected.begin(), expected.end());
+
+    logval::sort(vec.begin(), vec.end());
+    REQUIRE(vec == expected);
+
+    LogValArray<double> arr(expected.rbegin(), expected.rend());
+    logval::sort(arr.begin(), arr.end());
+    REQUIRE(std::equal(arr.cbegin(), arr.cend(), expected.begin()));
+}
+
+TEST_CASE("nth_element and top_k", "[sort]") {
+    auto vec = random_logvals(5000);
+    auto sorted = vec;
+    std::sort(sorted.begin(), sorted.end());
+
+    auto nth = GENERATE(0, 1, 2500, 4999);
+
+    auto selected = vec;
+    logval::nth_element(selected.begin(), selected.begin() + nth,
+                        selected.end());
+    REQUIRE(selected[nth] == sorted[nth]);
+    REQUIRE(std::all_of(selected.begin(), selected.begin() + nth,
+                        [&](auto val) { return val <= sorted[nth]; }));
+
+    const auto top = logval::top_k(vec.begin(), vec.end(), nth);
+    REQUIRE(top.size() == static_cast<std::size_t>(nth));
+    REQUIRE(std::equal(top.begin(), top.end(), sorted.rbegin()));
+
+    REQUIRE(logval::top_k(vec.begin(), vec.end(), 10000).size() == vec.size());
+}
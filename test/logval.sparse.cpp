@@ -0,0 +1,248 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/Matrix.hpp>
+#include <LogValCpp/Parallel.hpp>
+#include <LogValCpp/Sparse.hpp>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+using Sign = LogVal<double>::Sign;
+
+// About one in `sparsity` entries is non-zero.
+auto make_sparse(std::size_t rows, std::size_t cols, std::size_t sparsity)
+    -> std::vector<LogVal<double>> {
+    std::vector<LogVal<double>> res;
+    res.reserve(rows * cols);
+    for (std::size_t i = 0; i < rows * cols; ++i) {
+        res.emplace_back((i * 7919) % sparsity == 0
+                             ? std::sin(static_cast<double>(i)) * 3.0
+                             : 0.0);
+    }
+    return res;
+}
+
+}  // namespace
+
+TEST_CASE("Sparse matrix conversions", "[sparse]") {
+    // [[0, 2, 0], [-1, 0, 0], [0, 0, 0], [0, 3, 4]]
+    std::vector<LogVal<double>> dense{
+        LogVal(0.0), LogVal(2.0), LogVal(0.0), LogVal(-1.0),
+        LogVal(0.0), LogVal(0.0), LogVal(0.0), LogVal(0.0),
+        LogVal(0.0), LogVal(0.0), LogVal(3.0), LogVal(4.0)};
+
+    const auto csr = logval::CsrMatrix<LogVal<double>>::from_dense(
+        logval::MatrixView<const LogVal<double>>(dense.data(), 4, 3));
+    REQUIRE(csr.rows() == 4);
+    REQUIRE(csr.cols() == 3);
+    REQUIRE(csr.nnz() == 4);
+    REQUIRE(std::vector(csr.row_offsets().begin(), csr.row_offsets().end()) ==
+            std::vector<std::size_t>{0, 1, 2, 2, 4});
+    REQUIRE(std::vector(csr.col_indices().begin(), csr.col_indices().end()) ==
+            std::vector<std::size_t>{1, 0, 1, 2});
+    REQUIRE(csr.to_dense() == dense);
+
+    const auto transposed = csr.transposed();
+    REQUIRE(transposed.rows() == 3);
+    REQUIRE(transposed.cols() == 4);
+    const auto dense_transposed = transposed.to_dense();
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            REQUIRE(dense_transposed[j * 4 + i] == dense[i * 3 + j]);
+        }
+    }
+    REQUIRE(transposed.transposed().to_dense() == dense);
+
+    // Column-major input gives the same matrix.
+    std::vector<LogVal<double>> column_major(dense.size(), LogVal(0.0));
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            column_major[j * 4 + i] = dense[i * 3 + j];
+        }
+    }
+    const auto coo = logval::CooMatrix<LogVal<double>>::from_dense(
+        logval::MatrixView<const LogVal<double>>(
+            column_major.data(), 4, 3, logval::Layout::column_major));
+    REQUIRE(coo.nnz() == 4);
+    REQUIRE(coo.to_dense() == dense);
+    REQUIRE(logval::CsrMatrix(coo).to_dense() == dense);
+}
+
+TEST_CASE("Sparse matrix assembly", "[sparse]") {
+    logval::CooMatrix<LogVal<double>> coo(3, 3);
+    coo.add(2, 1, LogVal(1.0));
+    coo.add(0, 2, LogVal(5.0));
+    coo.add(2, 0, LogVal(0.0));  // dropped
+    coo.add(2, 1, LogVal(2.0));  // summed
+    coo.add(1, 1, LogVal(3.0));
+    coo.add(1, 1, LogVal(-3.0));  // cancels
+    coo.add(0, 0, LogVal(-1.0));
+    REQUIRE(coo.nnz() == 6);
+
+    const logval::CsrMatrix csr(coo);
+    REQUIRE(csr.nnz() == 3);
+    REQUIRE(std::vector(csr.row_offsets().begin(), csr.row_offsets().end()) ==
+            std::vector<std::size_t>{0, 2, 2, 3});
+    REQUIRE(std::vector(csr.col_indices().begin(), csr.col_indices().end()) ==
+            std::vector<std::size_t>{0, 2, 1});
+    REQUIRE(csr.values()[0].to() == -1.0);
+    REQUIRE_THAT(csr.values()[2].to(), Catch::Matchers::WithinRel(3.0, 1e-15));
+    REQUIRE(coo.to_dense()[4].sign() == Sign::null);
+
+    const logval::CsrMatrix<LogVal<double>> empty(2, 5);
+    REQUIRE(empty.nnz() == 0);
+    REQUIRE(empty.transposed().rows() == 5);
+}
+
+TEST_CASE("Sparse matrix vector product", "[sparse]") {
+    auto dims = GENERATE(std::array<std::size_t, 3>{1, 1, 1},
+                         std::array<std::size_t, 3>{17, 9, 3},
+                         std::array<std::size_t, 3>{300, 2500, 7});
+    const auto [m, n, sparsity] = dims;
+
+    auto dense = make_sparse(m, n, sparsity);
+    const auto x = make_sparse(n, 1, 2);
+    const logval::MatrixView<const LogVal<double>> view(dense.data(), m, n);
+    const auto csr = logval::CsrMatrix<LogVal<double>>::from_dense(view);
+
+    std::vector<LogVal<double>> expected(m, LogVal(0.0));
+    logval::gemv(view, x.data(), expected.data());
+    std::vector<LogVal<double>> res(m, LogVal(1.0));
+    logval::spmv(csr, x.data(), res.data());
+    std::vector<LogVal<double>> res_par(m, LogVal(1.0));
+    logval::par::spmv(csr, x.data(), res_par.data(), {.threads = 4});
+
+    for (std::size_t i = 0; i < m; ++i) {
+        REQUIRE_THAT(res[i].to(),
+                     Catch::Matchers::WithinAbs(expected[i].to(), 1e-12) ||
+                         Catch::Matchers::WithinRel(expected[i].to(), 1e-13));
+        REQUIRE(res_par[i] == res[i]);
+    }
+}
+
+TEST_CASE("Sparse matrix vector product beyond the range of double",
+          "[sparse]") {
+    // A = [[exp(800), -exp(801)], [0, exp(-900)]], x = [exp(100), 1]
+    logval::CooMatrix<LogVal<double>> coo(2, 2);
+    coo.add(0, 0, LogVal<double>::from_log(800.0));
+    coo.add(0, 1, LogVal<double>::from_log(801.0, Sign::negative));
+    coo.add(1, 1, LogVal<double>::from_log(-900.0));
+    const logval::CsrMatrix csr(coo);
+    const std::vector x{LogVal<double>::from_log(100.0), LogVal(1.0)};
+
+    std::vector<LogVal<double>> y(2, LogVal(0.0));
+    logval::spmv(csr, x.data(), y.data());
+    REQUIRE(y[0].sign() == Sign::positive);
+    REQUIRE_THAT(y[0].log_abs(),
+                 Catch::Matchers::WithinRel(
+                     900.0 + std::log1p(-std::exp(-99.0)), 1e-15));
+    REQUIRE(y[1].log_abs() == -900.0);
+}
+
+TEST_CASE("Sparse matrix product", "[sparse]") {
+    auto dims = GENERATE(std::array<std::size_t, 4>{1, 1, 1, 1},
+                         std::array<std::size_t, 4>{40, 30, 9, 3},
+                         std::array<std::size_t, 4>{257, 100, 33, 11});
+    auto layout = GENERATE(logval::Layout::row_major,
+                           logval::Layout::column_major);
+    const auto [m, k, n, sparsity] = dims;
+
+    auto a = make_sparse(m, k, sparsity);
+    auto b = make_sparse(k, n, 2);
+    const logval::MatrixView<const LogVal<double>> a_view(a.data(), m, k);
+    const logval::MatrixView<const LogVal<double>> b_view(b.data(), k, n,
+                                                          layout);
+    const auto csr = logval::CsrMatrix<LogVal<double>>::from_dense(a_view);
+
+    std::vector<LogVal<double>> expected(m * n, LogVal(0.0));
+    logval::gemm(a_view, b_view,
+                 logval::MatrixView(expected.data(), m, n, layout));
+    std::vector<LogVal<double>> res(m * n, LogVal(1.0));
+    logval::spmm(csr, b_view, logval::MatrixView(res.data(), m, n, layout));
+    std::vector<LogVal<double>> res_par(m * n, LogVal(1.0));
+    logval::par::spmm(csr, b_view,
+                      logval::MatrixView(res_par.data(), m, n, layout),
+                      {.threads = 3});
+
+    for (std::size_t i = 0; i < m * n; ++i) {
+        REQUIRE_THAT(res[i].to(),
+                     Catch::Matchers::WithinAbs(expected[i].to(), 1e-12) ||
+                         Catch::Matchers::WithinRel(expected[i].to(), 1e-13));
+        REQUIRE(res_par[i] == res[i]);
+    }
+}
+
+TEST_CASE("Sparse matrix product with a wide dynamic range", "[sparse]") {
+    // Every column of C = A B has to agree with spmv of A and that column.
+    auto check = [](const logval::CsrMatrix<LogVal<double>> &csr,
+                    const std::vector<LogVal<double>> &b, std::size_t n) {
+        const std::size_t k = csr.cols();
+        const std::size_t m = csr.rows();
+        const logval::MatrixView<const LogVal<double>> b_view(b.data(), k, n);
+        std::vector<LogVal<double>> res(m * n, LogVal(1.0));
+        logval::spmm(csr, b_view, logval::MatrixView(res.data(), m, n));
+        std::vector<LogVal<double>> res_par(m * n, LogVal(1.0));
+        logval::par::spmm(csr, b_view, logval::MatrixView(res_par.data(), m, n),
+                          {.threads = 2});
+
+        std::vector<LogVal<double>> column(k, LogVal(0.0));
+        std::vector<LogVal<double>> expected(m, LogVal(0.0));
+        for (std::size_t j = 0; j < n; ++j) {
+            for (std::size_t l = 0; l < k; ++l) {
+                column[l] = b_view(l, j);
+            }
+            logval::spmv(csr, column.data(), expected.data());
+            for (std::size_t i = 0; i < m; ++i) {
+                const auto val = res[i * n + j];
+                REQUIRE(val.sign() == expected[i].sign());
+                if (val.sign() != Sign::null) {
+                    REQUIRE_THAT(val.log_abs(),
+                                 Catch::Matchers::WithinAbs(
+                                     expected[i].log_abs(), 1e-9));
+                }
+                REQUIRE(res_par[i * n + j] == val);
+            }
+        }
+    };
+
+    // A = [1, e^-800], B = [[e^-800, 1], [1, e^-800]]: both products of
+    // C(0, 0) are e^-800, far below the maxima of the row and the column.
+    const auto tiny = LogVal<double>::from_log(-800.0);
+    const std::vector<LogVal<double>> a{LogVal(1.0), tiny};
+    const std::vector<LogVal<double>> b{tiny, LogVal(1.0), LogVal(1.0), tiny};
+    const auto csr = logval::CsrMatrix<LogVal<double>>::from_dense(
+        logval::MatrixView<const LogVal<double>>(a.data(), 1, 2));
+    std::vector<LogVal<double>> c(2, LogVal(0.0));
+    logval::spmm(csr, logval::MatrixView<const LogVal<double>>(b.data(), 2, 2),
+                 logval::MatrixView(c.data(), 1, 2));
+    REQUIRE(c[0].sign() == Sign::positive);
+    REQUIRE_THAT(c[0].log_abs(),
+                 Catch::Matchers::WithinRel(-800.0 + std::log(2.0), 1e-15));
+    check(csr, b, 2);
+
+    // Logarithms spread over [-1000, 1000].
+    const std::size_t m = 60;
+    const std::size_t k = 200;
+    const std::size_t n = 15;
+    auto make = [](std::size_t rows, std::size_t cols, double offset) {
+        std::vector<LogVal<double>> res;
+        for (std::size_t i = 0; i < rows * cols; ++i) {
+            const double x = offset + static_cast<double>(i);
+            res.push_back(i % 3 == 1 ? LogVal(0.0)
+                                     : LogVal<double>::from_log(
+                                           1000.0 * std::sin(x * x),
+                                           i % 5 == 0 ? Sign::negative
+                                                      : Sign::positive));
+        }
+        return res;
+    };
+    const auto wide_a = make(m, k, 0.0);
+    check(logval::CsrMatrix<LogVal<double>>::from_dense(
+              logval::MatrixView<const LogVal<double>>(wide_a.data(), m, k)),
+          make(k, n, 0.5), n);
+}
@@ -0,0 +1,106 @@
+#include <LogValCpp/LogVal.hpp>
+#include <LogValCpp/LogValArray.hpp>
+#include <LogValCpp/Sum.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <list>
+#include <numeric>
+#include <span>
+#include <vector>
+
+TEST_CASE("Sum of empty range", "[sum]") {
+    const std::vector<LogVal<double>> vec;
+
+    REQUIRE(logval::sum(vec.begin(), vec.end()) == LogVal(0.0));
+    REQUIRE(logval::sum(std::span(vec)) == LogVal(0.0));
+    REQUIRE(logval::sum(LogValArray<double>()) == LogVal(0.0));
+}
+
+TEST_CASE("Sum of positive numbers", "[sum]") {
+    // sizes around the block size and the number of lanes
+    auto size = GENERATE(1, 7, 8, 9, 1023, 1024, 1025, 5000);
+
+    std::vector<LogVal<double>> vec;
+    double expected = 0.0;
+    for (int i = 0; i < size; ++i) {
+        const double val = 1.0 + (i % 13);
+        vec.emplace_back(val);
+        expected += val;
+    }
+
+    REQUIRE_THAT(logval::sum(vec.begin(), vec.end()).to(),
+                 Catch::Matchers::WithinRel(expected, 1e-12));
+    REQUIRE_THAT(logval::sum(std::span(vec)).to(),
+                 Catch::Matchers::WithinRel(expected, 1e-12));
+
+    const LogValArray<double> arr(vec.begin(), vec.end());
+    REQUIRE_THAT(logval::sum(arr).to(),
+                 Catch::Matchers::WithinRel(expected, 1e-12));
+
+    const std::list<LogVal<double>> lst(vec.begin(), vec.end());
+    REQUIRE_THAT(logval::sum(lst.begin(), lst.end()).to(),
+                 Catch::Matchers::WithinRel(expected, 1e-12));
+}
+
+TEST_CASE("Sum with mixed signs and zeros", "[sum]") {
+    std::vector<LogVal<double>> vec;
+    double expected = 0.0;
+    for (int i = 0; i < 3000; ++i) {
+        const double val = (i % 3 == 0) ? 0.0 : (i % 2 == 0 ? 1.5 : -1.0) * i;
+        vec.emplace_back(val);
+        expected += val;
+    }
+
+    const auto res = logval::sum(vec.begin(), vec.end());
+    REQUIRE_THAT(res.to(), Catch::Matchers::WithinRel(expected, 1e-12));
+
+    const auto res_acc =
+        std::accumulate(vec.begin(), vec.end(), LogVal(0.0), std::plus<>());
+    REQUIRE_THAT(res.to(), Catch::Matchers::WithinRel(res_acc.to(), 1e-10));
+
+    const LogValArray<double> arr(vec.begin(), vec.end());
+    REQUIRE_THAT(logval::sum(arr).to(),
+                 Catch::Matchers::WithinRel(expected, 1e-12));
+}
+
+TEST_CASE("Sum with cancellation", "[sum]") {
+    // Like `operator+=` the cancellation is exact up to rounding only.
+    const std::vector<LogVal<double>> vec{LogVal(2.0), LogVal(-3.0),
+                                          LogVal(1.0)};
+    REQUIRE_THAT(logval::sum(std::span(vec)).to(),
+                 Catch::Matchers::WithinAbs(0.0, 1e-15));
+
+    const std::vector<LogVal<double>> exact{LogVal(2.0), LogVal(-2.0)};
+    REQUIRE(logval::sum(std::span(exact)) == LogVal(0.0));
+
+    const std::vector<LogVal<double>> neg{LogVal(2.0), LogVal(-3.0)};
+    REQUIRE_THAT(logval::sum(std::span(neg)).to(),
+                 Catch::Matchers::WithinRel(-1.0, 1e-12));
+}
+
+TEST_CASE("Sum beyond the range of double", "[sum]") {
+    // Blocks with very different magnitudes must be merged correctly.
+    std::vector<LogVal<double>> vec;
+    for (int i = 0; i < 4000; ++i) {
+        vec.push_back(LogVal<double>::from_log(1000.0 + i * 0.5));
+    }
+
+    const auto res = logval::sum(vec.begin(), vec.end());
+    // sum_i exp(1000 + i/2) = exp(1000) * (exp(2000) - 1) / (exp(0.5) - 1)
+    const double expected =
+        1000.0 + 2000.0 - std::log(std::exp(0.5) - 1.0);
+    REQUIRE_THAT(res.log_abs(), Catch::Matchers::WithinRel(expected, 1e-12));
+    REQUIRE(res.sign() == LogVal<double>::Sign::positive);
+}
+
+TEST_CASE("Sum of other floating point types", "[sum]") {
+    const std::vector<LogVal<float>> floats(100, LogVal(2.0F));
+    REQUIRE_THAT(logval::sum(std::span(floats)).to(),
+                 Catch::Matchers::WithinRel(200.0F, 1e-5F));
+
+    const std::vector<LogVal<long double>> longs(100, LogVal(-2.0L));
+    REQUIRE_THAT(static_cast<double>(logval::sum(std::span(longs)).to()),
+                 Catch::Matchers::WithinRel(-200.0, 1e-12));
+}